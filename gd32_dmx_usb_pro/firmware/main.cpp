@@ -37,7 +37,7 @@
 #define ALIGNED __attribute__((aligned(4)))
 #endif
 
-static constexpr char kWidgetModeNames[4][12] ALIGNED = {"DMX_RDM", "DMX", "RDM", "RDM_SNIFFER"};
+static constexpr char kWidgetModeNames[5][20] ALIGNED = {"DMX_RDM", "DMX", "RDM", "RDM_SNIFFER", "RDM_SNIFFER_COMPACT"};
 
 static constexpr rdm::device::InfoData kDeviceLabel ALIGNED = 
 {
@@ -72,7 +72,7 @@ int main() { // NOLINT
 
     watchdog::Init();
 
-    if (kWidgetMode == widget::Mode::kRdmSniffer) {
+    if ((kWidgetMode == widget::Mode::kRdmSniffer) || (kWidgetMode == widget::Mode::kRdmSnifferCompact)) {
         widget.SetPortDirection(0, dmx::Direction::kInput, true);
         widget.SnifferFillTransmitBuffer(); // Prevent missing first frame
     }
@@ -69,11 +69,21 @@ bool StoreDevice::Read(uint32_t offset, uint32_t length, uint8_t* buffer, stored
 bool StoreDevice::Erase(uint32_t offset, uint32_t length, storedevice::Result& result) {
     CONFIGSTORE_DEBUG_ENTRY();
 
+    if (!FlashCode::Acquire(flashcode::Owner::kConfigStore)) {
+        result = storedevice::Result::kOk;
+        CONFIGSTORE_DEBUG_EXIT();
+        return false;
+    }
+
     flashcode::Result flashrom_result;
     const auto kState = FlashCode::Erase(offset, length, flashrom_result);
 
     result = static_cast<storedevice::Result>(flashrom_result);
 
+    if (kState) {
+        FlashCode::Release(flashcode::Owner::kConfigStore);
+    }
+
     CONFIGSTORE_DEBUG_EXIT();
     return kState;
 }
@@ -81,11 +91,21 @@ bool StoreDevice::Erase(uint32_t offset, uint32_t length, storedevice::Result& r
 bool StoreDevice::Write(uint32_t offset, uint32_t length, const uint8_t* buffer, storedevice::Result& result) {
     CONFIGSTORE_DEBUG_ENTRY();
 
+    if (!FlashCode::Acquire(flashcode::Owner::kConfigStore)) {
+        result = storedevice::Result::kOk;
+        CONFIGSTORE_DEBUG_EXIT();
+        return false;
+    }
+
     flashcode::Result flashrom_result;
     const auto kState = FlashCode::Write(offset, length, buffer, flashrom_result);
 
     result = static_cast<storedevice::Result>(flashrom_result);
 
+    if (kState) {
+        FlashCode::Release(flashcode::Owner::kConfigStore);
+    }
+
     CONFIGSTORE_DEBUG_EXIT();
     return kState;
 }
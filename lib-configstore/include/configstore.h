@@ -35,6 +35,9 @@
 #include "global.h"
 #include "softwaretimers.h"
 #include "configstore_debug.h"
+#if defined(CONFIG_STORE_ENABLE_LOG)
+#include "configstore_log.h"
+#endif
 
 class ConfigStore : StoreDevice {
     static constexpr uint32_t kStoreSize = 4 * 1024;
@@ -49,17 +52,21 @@ class ConfigStore : StoreDevice {
         kErasing,        //
         kErased,         //
         kErasedWaiting,  //
-        kWriting         //
+        kWriting,        //
+        kWritingHeader,  //
+        kAppending       //
     };
 
-    [[maybe_unused]] static constexpr char kStateNames[7][16] = {
+    [[maybe_unused]] static constexpr char kStateNames[9][16] = {
         "IDLE",            //
         "CHANGED",         //
         "CHANGED_WAITING", //
         "ERASING",         //
         "ERASED",          //
         "ERASED_WAITING",  //
-        "WRITING"          //
+        "WRITING",         //
+        "WRITING_HEADER",  //
+        "APPENDING"        //
     };
 
    public:
@@ -91,10 +98,20 @@ class ConfigStore : StoreDevice {
 
             CONFIGSTORE_DEBUG_PRINTF("s_start_address=%p", reinterpret_cast<void*>(s_start_address));
 
-            storedevice::Result result;
-            while (!StoreDevice::Read(s_start_address, kStoreSize, reinterpret_cast<uint8_t*>(&s_store), result)) {
+#if defined(CONFIG_STORE_ENABLE_LOG)
+            if (!LogReplay()) {
+#endif
+                storedevice::Result result;
+                while (!StoreDevice::Read(s_start_address, kStoreSize, reinterpret_cast<uint8_t*>(&s_store), result)) {
+                }
+                assert(result == storedevice::Result::kOk);
+#if defined(CONFIG_STORE_ENABLE_LOG)
+                // Image written before the log was enabled, move it into the log
+                if (IsValid()) {
+                    SetStatusChanged(s_store, sizeof(ConfigurationStore));
+                }
             }
-            assert(result == storedevice::Result::kOk);
+#endif
         }
 
         auto* store = GetStore();
@@ -106,7 +123,7 @@ class ConfigStore : StoreDevice {
             memcpy(store->magic_number, &kMagicNumber, sizeof(kMagicNumber));
             memcpy(store->version, &kVersion, sizeof(kVersion));
 
-            SetStatusChanged();
+            SetStatusChanged(s_store, sizeof(ConfigurationStore));
         }
 
         // Set global
@@ -124,7 +141,7 @@ class ConfigStore : StoreDevice {
 
     void Reset() {
         memset(s_store, 0, sizeof(s_store));
-        SetStatusChanged();
+        SetStatusChanged(s_store, sizeof(ConfigurationStore));
     }
 
     bool Commit() { return Flash(); }
@@ -137,12 +154,7 @@ class ConfigStore : StoreDevice {
     template <typename TMember> void Store(const TMember* source, TMember ConfigurationStore::* member) {
         assert(source != nullptr);
 
-        auto* destination = &(GetStore()->*member);
-
-        if (__builtin_memcmp(destination, source, sizeof(TMember)) != 0) {
-            __builtin_memcpy(destination, source, sizeof(TMember));
-            SetStatusChanged();
-        }
+        UpdateBytes(&(GetStore()->*member), source, sizeof(TMember));
     }
 
 #define DEFINE_STORE_GETTERS_HELPERS(HumanName, StoreName, StoreType) \
@@ -312,7 +324,7 @@ class ConfigStore : StoreDevice {
 
         if (array[index] != value) {
             array[index] = value;
-            SetStatusChanged();
+            SetStatusChanged(&array[index], sizeof(T));
         }
     }
 
@@ -332,7 +344,7 @@ class ConfigStore : StoreDevice {
         if (__builtin_memcmp(labels[index], src, length) != 0) {
             memset(labels[index], 0, N);
             memcpy(labels[index], src, length);
-            SetStatusChanged();
+            SetStatusChanged(labels[index], N);
         }
     }
 
@@ -344,7 +356,7 @@ class ConfigStore : StoreDevice {
 
         if (array[index] != value) {
             array[index] = value;
-            SetStatusChanged();
+            SetStatusChanged(&array[index], sizeof(T));
         }
     }
 
@@ -386,20 +398,14 @@ class ConfigStore : StoreDevice {
         assert(src != nullptr);
         auto& dest = GetStore()->dmx_l6470.spark_fun_global;
 
-        if (__builtin_memcmp(&dest, src, sizeof(common::store::l6470dmx::SparkFun)) != 0) {
-            __builtin_memcpy(&dest, src, sizeof(common::store::l6470dmx::SparkFun));
-            SetStatusChanged();
-        }
+        UpdateBytes(&dest, src, sizeof(common::store::l6470dmx::SparkFun));
     }
 
     void DmxL6470StoreSparkFunIndexed(uint32_t index, const common::store::l6470dmx::SparkFun* src) {
         assert(index < common::store::l6470dmx::kMaxMotors);
         assert(src != nullptr);
         auto& ref = GetStore()->dmx_l6470.store[index].spark_fun;
-        if (__builtin_memcmp(&ref, src, sizeof(common::store::l6470dmx::SparkFun)) != 0) {
-            __builtin_memcpy(&ref, src, sizeof(common::store::l6470dmx::SparkFun));
-            SetStatusChanged();
-        }
+        UpdateBytes(&ref, src, sizeof(common::store::l6470dmx::SparkFun));
     }
 
     void DmxL6470StoreModeIndexed(uint32_t index, const common::store::l6470dmx::Mode* src) {
@@ -407,30 +413,21 @@ class ConfigStore : StoreDevice {
         assert(src != nullptr);
 
         auto& ref = GetStore()->dmx_l6470.store[index].mode;
-        if (__builtin_memcmp(&ref, src, sizeof(common::store::l6470dmx::Mode)) != 0) {
-            __builtin_memcpy(&ref, src, sizeof(common::store::l6470dmx::Mode));
-            SetStatusChanged();
-        }
+        UpdateBytes(&ref, src, sizeof(common::store::l6470dmx::Mode));
     }
 
     void DmxL6470StoreL6470Indexed(uint32_t index, const common::store::l6470dmx::L6470* src) {
         assert(index < common::store::l6470dmx::kMaxMotors);
         assert(src != nullptr);
         auto& ref = GetStore()->dmx_l6470.store[index].l6470;
-        if (__builtin_memcmp(&ref, src, sizeof(common::store::l6470dmx::L6470)) != 0) {
-            __builtin_memcpy(&ref, src, sizeof(common::store::l6470dmx::L6470));
-            SetStatusChanged();
-        }
+        UpdateBytes(&ref, src, sizeof(common::store::l6470dmx::L6470));
     }
 
     void DmxL6470StoreMotorIndexed(uint32_t index, const common::store::l6470dmx::Motor* src) {
         assert(index < common::store::l6470dmx::kMaxMotors);
         assert(src != nullptr);
         auto& ref = GetStore()->dmx_l6470.store[index].motor;
-        if (__builtin_memcmp(&ref, src, sizeof(common::store::l6470dmx::Motor)) != 0) {
-            __builtin_memcpy(&ref, src, sizeof(common::store::l6470dmx::Motor));
-            SetStatusChanged();
-        }
+        UpdateBytes(&ref, src, sizeof(common::store::l6470dmx::Motor));
     }
 
     template <typename TField> TField DmxL6470GetModeIndexed(uint32_t index, TField common::store::l6470dmx::Mode::* field) const {
@@ -454,12 +451,34 @@ class ConfigStore : StoreDevice {
     template <typename TObject, typename TField> void Update(TObject& object, TField TObject::* field, const TField& value) {
         assert(field != nullptr);
 
-        auto* dest = &(object.*field);
+        UpdateBytes(&(object.*field), &value, sizeof(TField));
+    }
+
+    /**
+     * Only the bytes which differ are copied and marked as changed.
+     */
+    void UpdateBytes(void* destination, const void* source, uint32_t length) {
+        auto* dest = static_cast<uint8_t*>(destination);
+        const auto* src = static_cast<const uint8_t*>(source);
+
+        uint32_t first = 0;
 
-        if (__builtin_memcmp(dest, &value, sizeof(TField)) != 0) {
-            __builtin_memcpy(dest, &value, sizeof(TField));
-            SetStatusChanged();
+        while ((first < length) && (dest[first] == src[first])) {
+            first++;
+        }
+
+        if (first == length) {
+            return;
         }
+
+        auto last = length;
+
+        while (dest[last - 1] == src[last - 1]) {
+            last--;
+        }
+
+        memcpy(&dest[first], &src[first], last - first);
+        SetStatusChanged(&dest[first], last - first);
     }
 
     template <typename TObject, typename TArray, std::size_t N> void UpdateArray(TObject& object, TArray (TObject::*field)[N], const TArray* src, uint32_t length) {
@@ -474,15 +493,69 @@ class ConfigStore : StoreDevice {
         if (__builtin_memcmp(dest, src, length * sizeof(TArray)) != 0) {
             memset(dest, 0, sizeof(TArray) * N);
             memcpy(dest, src, length * sizeof(TArray));
-            SetStatusChanged();
+            SetStatusChanged(dest, sizeof(TArray) * N);
         }
     }
 
-    void SetStatusChanged() {
+    void SetStatusChanged([[maybe_unused]] const void* data, [[maybe_unused]] uint32_t length) {
+#if defined(CONFIG_STORE_ENABLE_LOG)
+        LogChanged(static_cast<uint32_t>(static_cast<const uint8_t*>(data) - s_store), length);
+
+        // A write in progress is not restarted, the pending changes are appended when it is done
+        if ((s_state != State::kIdle) && (s_state != State::kChangedWaiting)) {
+            TimerStart();
+            return;
+        }
+#else
+        SetDirty(static_cast<uint32_t>(static_cast<const uint8_t*>(data) - s_store), length);
+#endif
         s_state = State::kChanged;
         TimerStart();
     }
 
+    /**
+     * Marks the sections of ConfigurationStore containing the changed bytes.
+     */
+    void SetDirty(uint32_t offset, uint32_t length) {
+        assert(length != 0);
+        assert((offset + length) <= sizeof(ConfigurationStore));
+
+        const auto kFirst = configurationstore::SectionIndex(offset);
+        const auto kLast = configurationstore::SectionIndex(offset + length - 1);
+
+        s_dirty |= ((2U << kLast) - 1) & ~((1U << kFirst) - 1);
+    }
+
+    /**
+     * Writes the next run of adjacent dirty sections.
+     * @return false when all sections are written
+     */
+    bool WriteDirtySections() {
+        if (s_dirty == 0) {
+            s_state = State::kIdle;
+            return false;
+        }
+
+        const auto kFirst = static_cast<uint32_t>(__builtin_ctz(s_dirty));
+        auto last = kFirst;
+
+        while (((last + 1) < configurationstore::kSectionCount) && ((s_dirty & (1U << (last + 1))) != 0)) {
+            last++;
+        }
+
+        const auto kOffset = configurationstore::kSections[kFirst].offset;
+        const auto kLength = configurationstore::kSections[last].offset + configurationstore::kSections[last].size - kOffset;
+
+        CONFIGSTORE_DEBUG_PRINTF("sections %u-%u, offset=%u, length=%u", static_cast<unsigned>(kFirst), static_cast<unsigned>(last), static_cast<unsigned>(kOffset), static_cast<unsigned>(kLength));
+
+        storedevice::Result result;
+        if (StoreDevice::Write(s_start_address + kOffset, static_cast<uint32_t>(kLength), &s_store[kOffset], result)) {
+            s_dirty &= ~(((2U << last) - 1) & ~((1U << kFirst) - 1));
+        }
+        assert(result == storedevice::Result::kOk);
+        return true;
+    }
+
     static void Timer([[maybe_unused]] TimerHandle_t timer_handle) {
         CONFIGSTORE_DEBUG_ENTRY();
 
@@ -533,11 +606,20 @@ class ConfigStore : StoreDevice {
             return false;
         }
 
+#if defined(CONFIG_STORE_ENABLE_LOG)
+        return LogFlash();
+#endif
+
         switch (s_state) {
             case State::kChanged:
                 s_state = State::kChangedWaiting;
                 return true;
             case State::kChangedWaiting:
+                if constexpr (storedevice::kIsByteWritable) {
+                    s_state = State::kWriting;
+                    SoftwareTimerChange(s_timer_id, 0);
+                    return true;
+                }
                 s_state = State::kErasing;
                 return true;
                 break;
@@ -559,8 +641,13 @@ class ConfigStore : StoreDevice {
                 return true;
                 break;
             case State::kWriting: {
+                if constexpr (storedevice::kIsByteWritable) {
+                    return WriteDirtySections();
+                }
+
                 storedevice::Result result;
                 if (StoreDevice::Write(s_start_address, sizeof(ConfigurationStore), reinterpret_cast<uint8_t*>(&s_store), result)) {
+                    s_dirty = 0;
                     s_state = State::kIdle;
                     return false;
                 }
@@ -585,7 +672,7 @@ class ConfigStore : StoreDevice {
         auto& flags = object.*field;
         if ((flags & flag) == 0) {
             flags |= flag;
-            SetStatusChanged();
+            SetStatusChanged(&flags, sizeof(flags));
         }
     }
 
@@ -593,7 +680,7 @@ class ConfigStore : StoreDevice {
         auto& flags = object.*field;
         if ((flags & flag) != 0) {
             flags &= ~flag;
-            SetStatusChanged();
+            SetStatusChanged(&flags, sizeof(flags));
         }
     }
 
@@ -607,7 +694,29 @@ class ConfigStore : StoreDevice {
         return memcmp(store->magic_number, kMagicNumber, sizeof(kMagicNumber)) == 0 && memcmp(store->version, kVersion, sizeof(kVersion)) == 0;
     }
 
-    static inline uint8_t s_store[kStoreSize];
+#if defined(CONFIG_STORE_ENABLE_LOG)
+    bool LogReplay();
+    void LogChanged(uint32_t offset, uint32_t length);
+    bool LogBuildRecord();
+    bool LogFlash();
+    uint32_t LogSectorAddress(uint32_t sector) const { return s_log_address + sector * StoreDevice::GetSectorSize(); }
+
+    static inline configstore::log::Range s_log_pending[configstore::log::kPendingMax];
+    static inline uint32_t s_log_pending_count{0};
+    static inline configstore::log::SectorHeader s_log_header;
+    static inline configstore::log::Record s_log_record;
+    static inline uint32_t s_log_record_size{0};
+    static inline uint32_t s_log_address{0};
+    static inline uint32_t s_log_sector{configstore::log::kSectors - 1};
+    static inline uint32_t s_log_sequence{0};
+    static inline uint32_t s_log_offset{0};
+    static inline bool s_log_compact{true};
+#endif
+
+    static_assert(configurationstore::kSectionCount <= 32, "s_dirty is a bit per section");
+
+    alignas(4) static inline uint8_t s_store[kStoreSize];
+    static inline uint32_t s_dirty{0};
     static inline uint32_t s_start_address{0};
     static inline bool s_have_device{false};
     static inline State s_state{State::kIdle};
@@ -616,6 +725,12 @@ class ConfigStore : StoreDevice {
 };
 
 inline void ConfigstoreCommit() {
+#if defined(CONFIG_STORE_USE_ROM) && !defined(USE_FREE_RTOS)
+    // Another owner (scene store) must be able to complete its flash operation
+    while (!FlashCode::IsFree()) {
+        SoftwareTimerRun();
+    }
+#endif
     while (ConfigStore::Instance().Commit()) {
     }
 }
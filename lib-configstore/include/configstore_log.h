@@ -0,0 +1,101 @@
+/**
+ * @file configstore_log.h
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef CONFIGSTORE_LOG_H_
+#define CONFIGSTORE_LOG_H_
+
+/**
+ * Append-only record log for ConfigStore on erasable flash (ROM, SPI).
+ *
+ * The log is a ring of sectors at the end of the store device. A sector holds:
+ * - SectorHeader, written last, so a sector without a valid header is never replayed
+ * - a snapshot of the complete ConfigurationStore
+ * - records appended for each change, until the sector is full
+ *
+ * When a record does not fit anymore, the next sector in the ring is erased
+ * and a new snapshot is written to it (compaction). The sector with the highest
+ * sequence number is the current one.
+ */
+
+#include <cstdint>
+
+#include "configurationstore.h"
+
+#if defined(CONFIG_STORE_USE_I2C) || defined(CONFIG_STORE_USE_RAM)
+#error CONFIG_STORE_ENABLE_LOG requires an erasable flash device
+#endif
+
+namespace configstore::log {
+#if !defined(CONFIG_STORE_LOG_SECTORS)
+#define CONFIG_STORE_LOG_SECTORS 2
+#endif
+inline constexpr uint32_t kSectors = CONFIG_STORE_LOG_SECTORS;
+static_assert(kSectors >= 2, "Compaction needs a spare sector");
+
+inline constexpr uint32_t kMagic = 0x4C567641; ///< "AvVL"
+inline constexpr uint8_t kErased = 0xFF;
+inline constexpr uint32_t kRecordDataMax = 64;
+inline constexpr uint32_t kPendingMax = 8;
+inline constexpr uint32_t kCompactThreshold = 256; ///< A larger change is written as a new snapshot
+
+struct SectorHeader {
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t sequence_inverted;
+    uint32_t reserved;
+};
+
+struct RecordHeader {
+    uint8_t section; ///< Index in configurationstore::kSections, kErased marks the end of the log
+    uint8_t length;
+    uint16_t offset; ///< Offset within the section
+    uint16_t crc;    ///< CRC-16/CCITT over section, length, offset and data
+    uint16_t reserved;
+};
+
+static_assert(sizeof(SectorHeader) == 16);
+static_assert(sizeof(RecordHeader) == 8);
+
+struct alignas(4) Record {
+    RecordHeader header;
+    uint8_t data[kRecordDataMax];
+};
+
+/// Changed bytes not yet written, offset is from the start of ConfigurationStore
+struct Range {
+    uint16_t offset;
+    uint16_t length;
+};
+
+constexpr uint32_t AlignedLength(uint32_t length) {
+    return (length + 3U) & ~3U;
+}
+
+inline constexpr uint32_t kSnapshotOffset = sizeof(SectorHeader);
+inline constexpr uint32_t kSnapshotSize = AlignedLength(sizeof(ConfigurationStore));
+inline constexpr uint32_t kRecordsOffset = kSnapshotOffset + kSnapshotSize;
+} // namespace configstore::log
+
+#endif // CONFIGSTORE_LOG_H_
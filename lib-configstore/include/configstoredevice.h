@@ -30,6 +30,16 @@
 
 namespace storedevice {
 enum class Result { kOk, kError };
+
+/**
+ * EEPROM and RAM are written without an erase, byte by byte.
+ * Flash (ROM, SPI) must be erased first, per sector.
+ */
+#if defined(CONFIG_STORE_USE_I2C) || defined(CONFIG_STORE_USE_RAM)
+inline constexpr bool kIsByteWritable = true;
+#else
+inline constexpr bool kIsByteWritable = false;
+#endif
 } // namespace storedevice
 
 #if defined(CONFIG_STORE_USE_I2C)
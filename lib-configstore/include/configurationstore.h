@@ -747,4 +747,64 @@ static_assert(offsetof(ConfigurationStore, global) == 16, "Wrong offset: global"
 #undef PACKED
 #endif
 
+namespace configurationstore {
+struct Section {
+    uint16_t offset;
+    uint16_t size;
+};
+
+#define CONFIGURATIONSTORE_SECTION(member) {static_cast<uint16_t>(offsetof(ConfigurationStore, member)), static_cast<uint16_t>(sizeof(ConfigurationStore::member))}
+
+/**
+ * The members of ConfigurationStore in memory order, index 0 is the header with magic number and version.
+ */
+inline constexpr Section kSections[] = {
+    {0, static_cast<uint16_t>(offsetof(ConfigurationStore, global))},
+    CONFIGURATIONSTORE_SECTION(global),
+    CONFIGURATIONSTORE_SECTION(remote_config),
+    CONFIGURATIONSTORE_SECTION(network),
+    CONFIGURATIONSTORE_SECTION(display_udf),
+    CONFIGURATIONSTORE_SECTION(dmx_node),
+    CONFIGURATIONSTORE_SECTION(osc_client),
+    CONFIGURATIONSTORE_SECTION(osc_server),
+    CONFIGURATIONSTORE_SECTION(dmx_send),
+    CONFIGURATIONSTORE_SECTION(dmx_l6470),
+    CONFIGURATIONSTORE_SECTION(dmx_led),
+    CONFIGURATIONSTORE_SECTION(dmx_pwm),
+    CONFIGURATIONSTORE_SECTION(dmx_serial),
+    CONFIGURATIONSTORE_SECTION(dmx_monitor),
+    CONFIGURATIONSTORE_SECTION(rdm_device),
+    CONFIGURATIONSTORE_SECTION(rdm_sensors),
+    CONFIGURATIONSTORE_SECTION(rdm_subdevices),
+    CONFIGURATIONSTORE_SECTION(show_file),
+    CONFIGURATIONSTORE_SECTION(ltc),
+    CONFIGURATIONSTORE_SECTION(ltc_display),
+    CONFIGURATIONSTORE_SECTION(ltc_etc),
+    CONFIGURATIONSTORE_SECTION(tcnet),
+    CONFIGURATIONSTORE_SECTION(gps),
+    CONFIGURATIONSTORE_SECTION(midi),
+    CONFIGURATIONSTORE_SECTION(rgb_panel),
+    CONFIGURATIONSTORE_SECTION(widget),
+};
+
+#undef CONFIGURATIONSTORE_SECTION
+
+inline constexpr uint32_t kSectionCount = sizeof(kSections) / sizeof(kSections[0]);
+
+static_assert(kSections[kSectionCount - 1].offset + kSections[kSectionCount - 1].size == sizeof(ConfigurationStore));
+
+/**
+ * @return index in kSections of the member containing the byte at offset
+ */
+constexpr uint32_t SectionIndex(uint32_t offset) {
+    uint32_t index = kSectionCount - 1;
+
+    while ((index != 0) && (offset < kSections[index].offset)) {
+        index--;
+    }
+
+    return index;
+}
+} // namespace configurationstore
+
 #endif // CONFIGURATIONSTORE_H_
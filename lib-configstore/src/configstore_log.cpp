@@ -0,0 +1,347 @@
+/**
+ * @file configstore_log.cpp
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined(CONFIG_STORE_ENABLE_LOG)
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#include "configstore.h"
+#include "configstore_log.h"
+#include "configurationstore.h"
+#include "softwaretimers.h"
+#include "configstore_debug.h"
+
+using configstore::log::AlignedLength;
+
+namespace {
+uint16_t Crc16(uint16_t crc, const uint8_t* data, uint32_t length) {
+    while (length-- > 0) {
+        crc = static_cast<uint16_t>(crc ^ (*data++ << 8));
+
+        for (uint32_t i = 0; i < 8; i++) {
+            if ((crc & 0x8000) != 0) {
+                crc = static_cast<uint16_t>((crc << 1) ^ 0x1021);
+            } else {
+                crc = static_cast<uint16_t>(crc << 1);
+            }
+        }
+    }
+
+    return crc;
+}
+
+uint16_t RecordCrc(const configstore::log::Record& record) {
+    const auto kCrc = Crc16(0xFFFF, reinterpret_cast<const uint8_t*>(&record.header), 4);
+    return Crc16(kCrc, record.data, record.header.length);
+}
+
+bool IsValidHeader(const configstore::log::SectorHeader& header) {
+    return (header.magic == configstore::log::kMagic) && (header.sequence == ~header.sequence_inverted);
+}
+
+bool IsNewer(uint32_t sequence, uint32_t reference) {
+    return static_cast<int32_t>(sequence - reference) > 0;
+}
+} // namespace
+
+/**
+ * Called from the constructor. Loads the snapshot of the current sector and applies the records appended to it.
+ * @return false when there is no valid log sector
+ */
+bool ConfigStore::LogReplay() {
+    CONFIGSTORE_DEBUG_ENTRY();
+
+    const auto kSectorSize = StoreDevice::GetSectorSize();
+
+    assert((configstore::log::kSectors * kSectorSize) <= StoreDevice::GetSize());
+    assert((configstore::log::kRecordsOffset + sizeof(configstore::log::Record)) <= kSectorSize);
+
+    s_log_address = StoreDevice::GetSize() - (configstore::log::kSectors * kSectorSize);
+
+    storedevice::Result result;
+    auto is_found = false;
+
+    for (uint32_t sector = 0; sector < configstore::log::kSectors; sector++) {
+        configstore::log::SectorHeader header;
+
+        while (!StoreDevice::Read(LogSectorAddress(sector), sizeof(header), reinterpret_cast<uint8_t*>(&header), result)) {
+        }
+        assert(result == storedevice::Result::kOk);
+
+        if (IsValidHeader(header) && (!is_found || IsNewer(header.sequence, s_log_sequence))) {
+            s_log_sector = sector;
+            s_log_sequence = header.sequence;
+            is_found = true;
+        }
+    }
+
+    if (!is_found) {
+        CONFIGSTORE_DEBUG_PUTS("No log");
+        CONFIGSTORE_DEBUG_EXIT();
+        return false;
+    }
+
+    const auto kAddress = LogSectorAddress(s_log_sector);
+
+    while (!StoreDevice::Read(kAddress + configstore::log::kSnapshotOffset, configstore::log::kSnapshotSize, s_store, result)) {
+    }
+    assert(result == storedevice::Result::kOk);
+
+    auto offset = configstore::log::kRecordsOffset;
+    uint32_t records = 0;
+
+    s_log_compact = false;
+
+    while ((offset + sizeof(configstore::log::RecordHeader)) <= kSectorSize) {
+        auto& record = s_log_record;
+
+        while (!StoreDevice::Read(kAddress + offset, sizeof(record.header), reinterpret_cast<uint8_t*>(&record.header), result)) {
+        }
+        assert(result == storedevice::Result::kOk);
+
+        if (record.header.section == configstore::log::kErased) {
+            break;
+        }
+
+        const auto kSize = static_cast<uint32_t>(sizeof(record.header)) + AlignedLength(record.header.length);
+
+        // An interrupted write leaves a record which is not erased, but is not valid either
+        if ((record.header.section >= configurationstore::kSectionCount) || (record.header.length > configstore::log::kRecordDataMax) ||
+            ((record.header.offset + record.header.length) > configurationstore::kSections[record.header.section].size) || ((offset + kSize) > kSectorSize)) {
+            s_log_compact = true;
+            break;
+        }
+
+        while (!StoreDevice::Read(kAddress + offset + sizeof(record.header), AlignedLength(record.header.length), record.data, result)) {
+        }
+        assert(result == storedevice::Result::kOk);
+
+        if (RecordCrc(record) != record.header.crc) {
+            s_log_compact = true;
+            break;
+        }
+
+        memcpy(&s_store[configurationstore::kSections[record.header.section].offset + record.header.offset], record.data, record.header.length);
+
+        offset += kSize;
+        records++;
+    }
+
+    s_log_offset = offset;
+
+    CONFIGSTORE_DEBUG_PRINTF("sector=%u, sequence=%u, records=%u, offset=%u", static_cast<unsigned>(s_log_sector), static_cast<unsigned>(s_log_sequence), static_cast<unsigned>(records),
+                             static_cast<unsigned>(offset));
+    CONFIGSTORE_DEBUG_EXIT();
+    return true;
+}
+
+/**
+ * Remembers which bytes are changed. Adjacent ranges are merged,
+ * when there are too many ranges, a new snapshot is written instead.
+ */
+void ConfigStore::LogChanged(uint32_t offset, uint32_t length) {
+    assert((offset + length) <= sizeof(ConfigurationStore));
+
+    if (length > configstore::log::kCompactThreshold) {
+        s_log_compact = true;
+        return;
+    }
+
+    const auto kEnd = offset + length;
+
+    for (uint32_t i = 0; i < s_log_pending_count; i++) {
+        auto& range = s_log_pending[i];
+        const auto kRangeEnd = static_cast<uint32_t>(range.offset + range.length);
+
+        if ((offset <= kRangeEnd) && (kEnd >= range.offset)) {
+            const auto kOffset = offset < range.offset ? offset : range.offset;
+            const auto kMergedEnd = kEnd > kRangeEnd ? kEnd : kRangeEnd;
+
+            range.offset = static_cast<uint16_t>(kOffset);
+            range.length = static_cast<uint16_t>(kMergedEnd - kOffset);
+            return;
+        }
+    }
+
+    if (s_log_pending_count == configstore::log::kPendingMax) {
+        s_log_compact = true;
+        return;
+    }
+
+    s_log_pending[s_log_pending_count].offset = static_cast<uint16_t>(offset);
+    s_log_pending[s_log_pending_count].length = static_cast<uint16_t>(length);
+    s_log_pending_count++;
+}
+
+/**
+ * Takes the next record from the pending ranges. A record does not cross a section boundary.
+ * @return false when nothing is pending
+ */
+bool ConfigStore::LogBuildRecord() {
+    if (s_log_pending_count == 0) {
+        return false;
+    }
+
+    auto& range = s_log_pending[0];
+    const auto kSection = configurationstore::SectionIndex(range.offset);
+    const auto& section = configurationstore::kSections[kSection];
+    const auto kOffset = static_cast<uint32_t>(range.offset - section.offset);
+
+    auto length = static_cast<uint32_t>(range.length);
+
+    if (length > (section.size - kOffset)) {
+        length = section.size - kOffset;
+    }
+
+    if (length > configstore::log::kRecordDataMax) {
+        length = configstore::log::kRecordDataMax;
+    }
+
+    auto& record = s_log_record;
+
+    record.header.section = static_cast<uint8_t>(kSection);
+    record.header.length = static_cast<uint8_t>(length);
+    record.header.offset = static_cast<uint16_t>(kOffset);
+    record.header.reserved = 0;
+
+    memcpy(record.data, &s_store[range.offset], length);
+    memset(&record.data[length], 0, AlignedLength(length) - length);
+
+    record.header.crc = RecordCrc(record);
+
+    s_log_record_size = static_cast<uint32_t>(sizeof(record.header)) + AlignedLength(length);
+
+    range.offset = static_cast<uint16_t>(range.offset + length);
+    range.length = static_cast<uint16_t>(range.length - length);
+
+    if (range.length == 0) {
+        s_log_pending_count--;
+        memmove(&s_log_pending[0], &s_log_pending[1], s_log_pending_count * sizeof(s_log_pending[0]));
+    }
+
+    return true;
+}
+
+/**
+ * Replaces Flash() when the log is enabled. A change is a record write of a few bytes,
+ * a sector is only erased when the current sector is full.
+ */
+bool ConfigStore::LogFlash() {
+    const auto kSectorSize = StoreDevice::GetSectorSize();
+    const auto kTarget = (s_log_sector + 1) % configstore::log::kSectors;
+
+    switch (s_state) {
+        case State::kChanged:
+            s_state = State::kChangedWaiting;
+            return true;
+            break;
+        case State::kChangedWaiting:
+            s_state = s_log_compact ? State::kErasing : State::kAppending;
+            SoftwareTimerChange(s_timer_id, 0);
+            return true;
+            break;
+        case State::kErasing: {
+            storedevice::Result result;
+            if (StoreDevice::Erase(LogSectorAddress(kTarget), kSectorSize, result)) {
+                s_state = State::kErasedWaiting;
+            }
+            assert(result == storedevice::Result::kOk);
+            return true;
+        } break;
+        case State::kErasedWaiting:
+            s_state = State::kErased;
+            return true;
+            break;
+        case State::kErased:
+            // The snapshot includes everything changed so far
+            s_log_pending_count = 0;
+            s_log_compact = false;
+            s_state = State::kWriting;
+            return true;
+            break;
+        case State::kWriting: {
+            storedevice::Result result;
+            if (StoreDevice::Write(LogSectorAddress(kTarget) + configstore::log::kSnapshotOffset, configstore::log::kSnapshotSize, s_store, result)) {
+                s_log_header.magic = configstore::log::kMagic;
+                s_log_header.sequence = s_log_sequence + 1;
+                s_log_header.sequence_inverted = ~s_log_header.sequence;
+                s_log_header.reserved = 0;
+                s_state = State::kWritingHeader;
+            }
+            assert(result == storedevice::Result::kOk);
+            return true;
+        } break;
+        case State::kWritingHeader: {
+            storedevice::Result result;
+            if (StoreDevice::Write(LogSectorAddress(kTarget), sizeof(s_log_header), reinterpret_cast<const uint8_t*>(&s_log_header), result)) {
+                s_log_sector = kTarget;
+                s_log_sequence = s_log_header.sequence;
+                s_log_offset = configstore::log::kRecordsOffset;
+                s_state = State::kAppending;
+                CONFIGSTORE_DEBUG_PRINTF("Compacted: sector=%u, sequence=%u", static_cast<unsigned>(s_log_sector), static_cast<unsigned>(s_log_sequence));
+            }
+            assert(result == storedevice::Result::kOk);
+            return true;
+        } break;
+        case State::kAppending: {
+            if (s_log_record_size == 0) {
+                if (s_log_compact) {
+                    s_state = State::kErasing;
+                    return true;
+                }
+
+                if (!LogBuildRecord()) {
+                    s_state = State::kIdle;
+                    return false;
+                }
+
+                if ((s_log_offset + s_log_record_size) > kSectorSize) {
+                    s_log_record_size = 0;
+                    s_log_compact = true;
+                    s_state = State::kErasing;
+                    return true;
+                }
+            }
+
+            storedevice::Result result;
+            if (StoreDevice::Write(LogSectorAddress(s_log_sector) + s_log_offset, s_log_record_size, reinterpret_cast<const uint8_t*>(&s_log_record), result)) {
+                s_log_offset += s_log_record_size;
+                s_log_record_size = 0;
+            }
+            assert(result == storedevice::Result::kOk);
+            return true;
+        } break;
+        default:
+            assert(0);
+            __builtin_unreachable();
+            break;
+    }
+
+    assert(0);
+    __builtin_unreachable();
+    return false;
+}
+#endif
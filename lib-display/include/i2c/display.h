@@ -55,6 +55,22 @@
 
 namespace display {
 enum class Type { kPcf8574T1602, kPcf8574T2004, kSsd1306, kSsd1311, kUnknown };
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+/**
+ * The text is written into a shadow framebuffer, only characters that differ mark their row dirty.
+ * Run() sends the changed part of at most kRowsPerRun dirty rows (an SSD1306 page for a row).
+ */
+namespace framebuffer {
+inline constexpr uint32_t kColumnsMax = 21; ///< SSD1306 128 / 6
+inline constexpr uint32_t kRowsMax = 8;     ///< SSD1306 64 / 8
+#if defined(CONFIG_DISPLAY_FRAMEBUFFER_ROWS_PER_RUN)
+inline constexpr uint32_t kRowsPerRun = CONFIG_DISPLAY_FRAMEBUFFER_ROWS_PER_RUN;
+#else
+inline constexpr uint32_t kRowsPerRun = 1;
+#endif
+static_assert(kRowsMax <= 32, "dirty_rows_ is a bit mask");
+} // namespace framebuffer
+#endif
 } // namespace display
 
 class Display {
@@ -90,7 +106,12 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        cursor_ = 0;
+        Fill(0, lcd_display_->GetColumns() * lcd_display_->GetRows());
+#else
         lcd_display_->Cls();
+#endif
     }
 
     void ClearLine(uint32_t line) {
@@ -98,7 +119,16 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        if ((line == 0) || (line > lcd_display_->GetRows())) {
+            return;
+        }
+
+        cursor_ = (line - 1U) * lcd_display_->GetColumns();
+        Fill(cursor_, cursor_ + lcd_display_->GetColumns());
+#else
         lcd_display_->ClearLine(line);
+#endif
     }
 
     void PutChar(int c) {
@@ -106,7 +136,13 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        if (cursor_ < (lcd_display_->GetColumns() * lcd_display_->GetRows())) {
+            Put(cursor_++, static_cast<char>(c));
+        }
+#else
         lcd_display_->PutChar(c);
+#endif
     }
 
     void PutString(const char* text) {
@@ -114,7 +150,21 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        const auto kColumns = lcd_display_->GetColumns();
+        const auto kEndOfLine = ((cursor_ / kColumns) + 1U) * kColumns;
+
+        while (*text != '\0') {
+            PutChar(static_cast<int>(*text++));
+        }
+
+        if (clear_end_of_line_) {
+            clear_end_of_line_ = false;
+            Fill(cursor_, kEndOfLine);
+        }
+#else
         lcd_display_->PutString(text);
+#endif
     }
 
     int Write(uint32_t line, const char* text) {
@@ -131,7 +181,7 @@ class Display {
             ++p;
         }
 
-        lcd_display_->TextLine(line, text, count);
+        TextLine(line, text, count);
 
         return static_cast<int>(count);
     }
@@ -151,7 +201,7 @@ class Display {
 
         va_end(arp);
 
-        lcd_display_->TextLine(line, buffer, static_cast<uint32_t>(i));
+        TextLine(line, buffer, static_cast<uint32_t>(i));
 
         return i;
     }
@@ -161,7 +211,30 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        const auto kColumns = lcd_display_->GetColumns();
+
+        if ((line == 0) || (line > lcd_display_->GetRows())) {
+            return;
+        }
+
+        if (length > kColumns) {
+            length = kColumns;
+        }
+
+        cursor_ = (line - 1U) * kColumns;
+
+        for (uint32_t i = 0; i < length; i++) {
+            Put(cursor_++, text[i]);
+        }
+
+        if (clear_end_of_line_) {
+            clear_end_of_line_ = false;
+            Fill(cursor_, line * kColumns);
+        }
+#else
         lcd_display_->TextLine(line, text, length);
+#endif
     }
 
     void TextStatus(const char* text) {
@@ -196,6 +269,15 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        cursor_mode_ = mode;
+
+        if (mode != display::cursor::kOff) {
+            // The hardware cursor must be on the character written last
+            Flush();
+        }
+#endif
+
         lcd_display_->SetCursor(mode);
     }
 
@@ -204,7 +286,19 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        if ((col >= lcd_display_->GetColumns()) || (row >= lcd_display_->GetRows())) {
+            return;
+        }
+
+        cursor_ = row * lcd_display_->GetColumns() + col;
+
+        if (cursor_mode_ != display::cursor::kOff) {
+            Flush();
+        }
+#else
         lcd_display_->SetCursorPos(col, row);
+#endif
     }
 
     void SetContrast(uint8_t contrast) {
@@ -234,7 +328,11 @@ class Display {
             return;
         }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        clear_end_of_line_ = true;
+#else
         lcd_display_->ClearEndOfLine();
+#endif
     }
 
     bool GetFlipVertically() const { return is_flipped_vertically_; }
@@ -290,7 +388,21 @@ class Display {
 
     uint32_t GetSleepTimeout() const { return sleep_timeout_ / 1000U / 60U; }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+    /**
+     * Sends the dirty rows, at most rows_max of them. The rows are visited round robin,
+     * so a row which is updated in every loop does not hold back the others.
+     */
+    void Flush(uint32_t rows_max = display::framebuffer::kRowsMax);
+#endif
+
     void Run() {
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+        if ((dirty_rows_ != 0) && !lcd_display_->IsBusy()) {
+            Flush(display::framebuffer::kRowsPerRun);
+        }
+#endif
+
         if (sleep_timeout_ == 0) {
             return;
         }
@@ -313,6 +425,11 @@ class Display {
     void Detect(display::Type display_type);
     void Detect(uint32_t rows);
     void SetSleepTimer(bool active);
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+    void FrameBufferInit();
+    void Put(uint32_t index, char c);
+    void Fill(uint32_t from, uint32_t to);
+#endif
 
    private:
     display::Type type_{display::Type::kUnknown};
@@ -323,6 +440,16 @@ class Display {
     bool is_flipped_vertically_{false};
 
     DisplaySet* lcd_display_{nullptr};
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+    uint32_t cursor_{0};
+    uint32_t cursor_mode_{display::cursor::kOff};
+    uint32_t dirty_rows_{0};
+    uint32_t flush_row_{0};
+    bool clear_end_of_line_{false};
+    uint8_t dirty_first_[display::framebuffer::kRowsMax];
+    uint8_t dirty_last_[display::framebuffer::kRowsMax];
+    char frame_buffer_[display::framebuffer::kColumnsMax * display::framebuffer::kRowsMax];
+#endif
     static inline Display* s_this;
 };
 
@@ -51,7 +51,7 @@ class Hd44780 final : public DisplaySet {
     void PutChar(int) override;
     void PutString(const char*) override;
 
-    void Text(const char* data, uint32_t length);
+    void Text(const char* data, uint32_t length) override;
     void TextLine(uint32_t line, const char* data, uint32_t length) override;
 
     void SetCursorPos(uint32_t col, uint32_t row) override;
@@ -59,7 +59,7 @@ class Ssd1306 final : public DisplaySet {
     void PutChar(int) override;
     void PutString(const char*) override;
 
-    void Text(const char* data, uint32_t length);
+    void Text(const char* data, uint32_t length) override;
     void TextLine(uint32_t line, const char* data, uint32_t length) override;
 
     void SetCursorPos(uint32_t column, uint32_t row) override;
@@ -72,6 +72,10 @@ class Ssd1306 final : public DisplaySet {
 
     void PrintInfo() override;
 
+#if defined(CONFIG_I2C_ASYNC)
+    bool IsBusy() override;
+#endif
+
     bool IsSH1106() { return have_sh1106_; }
 
     static Ssd1306* Get() { return s_this; }
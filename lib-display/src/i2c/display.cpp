@@ -24,6 +24,7 @@
  */
 
 #include <cstdint>
+#include <cstring>
 #include <cassert>
 
 #include "display.h"
@@ -55,6 +56,9 @@ Display::Display() {
 	DISPLAY_DEBUG_ENTRY();
     assert(s_this == nullptr);
     s_this = this;
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+    FrameBufferInit();
+#endif
 
 #if defined(CONFIG_DISPLAY_ENABLE_SSD1311)
     Detect(display::Type::kSsd1311);
@@ -78,6 +82,9 @@ Display::Display(uint32_t rows) {
 	
     assert(s_this == nullptr);
     s_this = this;
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+    FrameBufferInit();
+#endif
 
     Detect(rows);
 
@@ -92,6 +99,9 @@ Display::Display(uint32_t rows) {
 Display::Display(display::Type type) : type_(type) {
     assert(s_this == nullptr);
     s_this = this;
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+    FrameBufferInit();
+#endif
 
     Detect(type);
 
@@ -202,6 +212,85 @@ void Display::Detect(uint32_t rows) {
     }
 }
 
+#if defined(CONFIG_DISPLAY_ENABLE_FRAMEBUFFER)
+/*
+ * The display is cleared by Start(), so a framebuffer with spaces matches the display.
+ */
+void Display::FrameBufferInit() {
+    memset(frame_buffer_, ' ', sizeof(frame_buffer_));
+    dirty_rows_ = 0;
+}
+
+void Display::Put(uint32_t index, char c) {
+    if (frame_buffer_[index] == c) {
+        return;
+    }
+
+    frame_buffer_[index] = c;
+
+    const auto kColumns = lcd_display_->GetColumns();
+    const auto kRow = index / kColumns;
+    const auto kColumn = static_cast<uint8_t>(index - kRow * kColumns);
+    const auto kMask = 1U << kRow;
+
+    if ((dirty_rows_ & kMask) == 0) {
+        dirty_rows_ |= kMask;
+        dirty_first_[kRow] = kColumn;
+        dirty_last_[kRow] = kColumn;
+        return;
+    }
+
+    if (kColumn < dirty_first_[kRow]) {
+        dirty_first_[kRow] = kColumn;
+    } else if (kColumn > dirty_last_[kRow]) {
+        dirty_last_[kRow] = kColumn;
+    }
+}
+
+void Display::Fill(uint32_t from, uint32_t to) {
+    for (auto index = from; index < to; index++) {
+        Put(index, ' ');
+    }
+}
+
+void Display::Flush(uint32_t rows_max) {
+    if (lcd_display_ == nullptr) {
+        return;
+    }
+
+    const auto kColumns = lcd_display_->GetColumns();
+    const auto kRows = lcd_display_->GetRows();
+
+    for (uint32_t count = 0; (dirty_rows_ != 0) && (count < rows_max);) {
+        const auto kRow = flush_row_;
+
+        if (++flush_row_ == kRows) {
+            flush_row_ = 0;
+        }
+
+        const auto kMask = 1U << kRow;
+
+        if ((dirty_rows_ & kMask) == 0) {
+            continue;
+        }
+
+        dirty_rows_ &= ~kMask;
+
+        const auto kFirst = dirty_first_[kRow];
+        const auto kLength = static_cast<uint32_t>(dirty_last_[kRow] - kFirst + 1);
+
+        lcd_display_->SetCursorPos(kFirst, kRow);
+        lcd_display_->Text(&frame_buffer_[kRow * kColumns + kFirst], kLength);
+
+        count++;
+    }
+
+    if (cursor_mode_ != display::cursor::kOff) {
+        lcd_display_->SetCursorPos(cursor_ % kColumns, cursor_ / kColumns);
+    }
+}
+#endif
+
 #undef DISPLAY_DEBUG_ENTRY
 #undef DISPLAY_DEBUG_EXIT
 #undef DISPLAY_DEBUG_PRINTF
@@ -214,6 +214,15 @@ static constexpr uint8_t kOled128x32Init[] __attribute__((aligned(4))) = {
 
 static uint8_t s_clear_buffer[133 + 1] __attribute__((aligned(4)));
 
+#if defined(CONFIG_I2C_ASYNC)
+/*
+ * Text() sends the glyphs of a row as one queued transaction and returns.
+ * The cursor commands before it are queued in order.
+ */
+static uint8_t s_text_buffer[1 + ssd1306::oled::font8x6::kCols * ssd1306::oled::font8x6::kCharW] __attribute__((aligned(4)));
+static Gd32I2cTransaction s_transaction;
+#endif
+
 Ssd1306::Ssd1306() : i2c_(OLED_I2C_ADDRESS_DEFAULT) {
     DISPLAY_DEBUG_ENTRY();
     assert(s_this == nullptr);
@@ -410,6 +419,46 @@ void Ssd1306::Text(const char* data, uint32_t length) {
         length = cols_;
     }
 
+#if defined(CONFIG_I2C_ASYNC)
+    // s_text_buffer is in use until the previous row has been sent
+    while (s_transaction.rc == gd32::i2c::kPending) {
+        Gd32I2cRun();
+    }
+
+    const auto kColumns = clear_end_of_line_ ? cols_ : length;
+    clear_end_of_line_ = false;
+
+    auto* glyphs = &s_text_buffer[1];
+
+    for (uint32_t i = 0; i < kColumns; i++) {
+        auto c = (i < length) ? static_cast<int>(data[i]) : ' ';
+
+        if (c < 32 || c > 127) {
+            c = 32;
+        }
+
+#if defined(CONFIG_DISPLAY_ENABLE_CURSOR_MODE) || defined(CONFIG_DISPLAY_FIX_FLIP_VERTICALLY)
+        shadow_ram_[shadow_ram_index_++] = static_cast<char>(c);
+#endif
+        memcpy(glyphs, kOledFont8x6 + (ssd1306::oled::font8x6::kCharW + 1) * (c - 32) + 1, ssd1306::oled::font8x6::kCharW);
+        glyphs += ssd1306::oled::font8x6::kCharW;
+    }
+
+    s_text_buffer[0] = ssd1306::mode::kData;
+
+    s_transaction.address = i2c_.GetAddress();
+    s_transaction.write_buffer = s_text_buffer;
+    s_transaction.write_length = static_cast<uint32_t>(glyphs - s_text_buffer);
+    s_transaction.read_buffer = nullptr;
+    s_transaction.read_length = 0;
+    s_transaction.baudrate = i2c_.GetBaudrate();
+    s_transaction.callback = nullptr;
+    s_transaction.context = nullptr;
+
+    while (!Gd32I2cSubmit(&s_transaction)) {
+        Gd32I2cRun();
+    }
+#else
     uint32_t i;
 
     for (i = 0; i < length; i++) {
@@ -422,8 +471,15 @@ void Ssd1306::Text(const char* data, uint32_t length) {
             Ssd1306::PutChar(' ');
         }
     }
+#endif
 }
 
+#if defined(CONFIG_I2C_ASYNC)
+bool Ssd1306::IsBusy() {
+    return s_transaction.rc == gd32::i2c::kPending;
+}
+#endif
+
 /**
  * (0,0)
  */
@@ -51,7 +51,17 @@ inline constexpr uint32_t kChannelsMax = 512;
 inline constexpr uint32_t kSlotsMax = 1 + kChannelsMax; ///< Start code + channels
 inline constexpr uint32_t kSlotTime = 44; ///< 40us + 4us space 
 inline constexpr uint32_t kBaudRate = 250000;
+inline constexpr uint32_t kChangedBlockSlots = 32; ///< Slots per bit in ChangedSlots::blocks
 
+/**
+ * Result of the change detection on received DMX data.
+ * Slot 0 is the start code, so slot n is DMX address n.
+ */
+struct ChangedSlots {
+    uint32_t first;  ///< First changed slot
+    uint32_t last;   ///< Last changed slot
+    uint32_t blocks; ///< Bit n is set when a slot in [n * kChangedBlockSlots, (n + 1) * kChangedBlockSlots - 1] has changed
+};
 
 namespace transmit {
 inline constexpr uint32_t kBreakTimeMin = 92;                                ///< 92 us
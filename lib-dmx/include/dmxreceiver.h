@@ -100,6 +100,8 @@ class DMXReceiver : Dmx {
 
     const uint8_t* GetDmxCurrentData(uint32_t port_index) { return Dmx::GetDmxCurrentData(port_index); }
 
+    bool GetDmxChangedSlots(dmx::ChangedSlots& changed) { return Dmx::GetDmxChangedSlots(0, changed); }
+
     void Print() { printf(" Output %s\n", disable_output_ ? "disabled" : "enabled"); }
 
    private:
@@ -47,6 +47,22 @@ struct TotalStatistics {
         } sent;
     } rdm;
 };
+
+/**
+ * Timing of the last received DMX or RDM frame.
+ * The timestamps are in CPU cycles (DWT->CYCCNT) and are taken when the byte is received,
+ * so the BREAK is detected one slot time after it has started.
+ */
+struct ReceiveTiming {
+    uint32_t break_timestamp;      ///< BREAK detected (frame error)
+    uint32_t start_code_timestamp; ///< Start code received
+    uint32_t end_timestamp;        ///< Last slot received
+    uint32_t break_mab_time;       ///< Measured BREAK + MAB in microseconds
+    uint32_t frame_time;           ///< Start code to last slot in microseconds
+    uint32_t break_age;            ///< BREAK detected until GetDmxReceiveTiming in microseconds
+    uint32_t frames;               ///< Number of frames measured
+    uint8_t start_code;
+};
 } // namespace dmx
 
 #endif // DMXSTATISTICS_H_
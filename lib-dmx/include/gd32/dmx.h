@@ -57,17 +57,22 @@ class Dmx {
     volatile dmx::TotalStatistics& GetTotalStatistics(uint32_t port_index);
 
     // DMX Transmit
+    // The timing is per port. The functions without port_index apply to all ports.
+    void SetTransmitBreakTime(uint32_t port_index, uint32_t break_time);
     void SetTransmitBreakTime(uint32_t break_time);
-    [[nodiscard]] uint32_t TransmitBreakTime() const;
+    [[nodiscard]] uint32_t TransmitBreakTime(uint32_t port_index = 0) const;
 
+    void SetTransmitMabTime(uint32_t port_index, uint32_t mab_time);
     void SetTransmitMabTime(uint32_t mab_time);
-    [[nodiscard]] uint32_t TransmitMabTime() const;
+    [[nodiscard]] uint32_t TransmitMabTime(uint32_t port_index = 0) const;
 
+    void SetTransmitPeriodTime(uint32_t port_index, uint32_t period_time);
     void SetTransmitPeriodTime(uint32_t period_time);
-    [[nodiscard]] uint32_t TransmitPeriodTime() const { return transmit_period_; }
+    [[nodiscard]] uint32_t TransmitPeriodTime(uint32_t port_index = 0) const;
 
+    void SetTransmitSlots(uint32_t port_index, uint16_t slots);
     void SetTransmitSlots(uint16_t slots = dmx::kChannelsMax);
-    [[nodiscard]] uint16_t TransmitSlots() const { return transmit_slots_; }
+    [[nodiscard]] uint16_t TransmitSlots(uint32_t port_index = 0) const;
 
     template <dmx::SendStyle dmxSendStyle> 
     void SetTransmitDataWithSC(uint32_t port_index, const uint8_t* data, uint32_t length);
@@ -86,9 +91,20 @@ class Dmx {
     // DMX Receive
     const uint8_t* GetDmxAvailable(uint32_t port_index);
     const uint8_t* GetDmxChanged(uint32_t port_index);
+    const uint8_t* GetDmxChanged(uint32_t port_index, dmx::ChangedSlots& changed);
+    /**
+     * Compares the current data with the data of the previous call, one word at a time.
+     * Only the slots in the packet are compared. To be used after GetDmxAvailable.
+     * @return true when changed is valid
+     */
+    bool GetDmxChangedSlots(uint32_t port_index, dmx::ChangedSlots& changed);
     const uint8_t* GetDmxCurrentData(uint32_t port_index);
 
     uint32_t GetDmxUpdatesPerSecond(uint32_t port_index);
+    /**
+     * @return false when no frame has been measured yet
+     */
+    bool GetDmxReceiveTiming(uint32_t port_index, dmx::ReceiveTiming& receive_timing);
 
     // RDM Send
     void RdmTransmit(uint32_t port_index, const uint8_t* data, uint32_t length);
@@ -96,6 +112,10 @@ class Dmx {
 
     // RDM Receive
     const uint8_t* RdmReceive(uint32_t port_index);
+    /**
+     * @param length the number of bytes received, including a discovery response without BREAK
+     */
+    const uint8_t* RdmReceive(uint32_t port_index, uint32_t& length);
     const uint8_t* RdmReceiveTimeOut(uint32_t port_index, uint16_t timeout_ms);
 
     static Dmx* Get() { return s_this; }
@@ -115,10 +135,10 @@ class Dmx {
 
     void StartRdmOutput(uint32_t port_index);
 
-    uint32_t transmit_period_{dmx::transmit::kPeriodDefault};
-    uint32_t transmit_period_requested_{dmx::transmit::kPeriodDefault};
+    uint32_t transmit_period_[dmx::config::max::kPorts];
+    uint32_t transmit_period_requested_[dmx::config::max::kPorts];
     uint32_t transmit_length_[dmx::config::max::kPorts];
-    uint16_t transmit_slots_{dmx::kChannelsMax};
+    uint16_t transmit_slots_[dmx::config::max::kPorts];
     dmx::Direction port_direction_[dmx::config::max::kPorts];
     bool has_continuous_output_{false};
 
@@ -0,0 +1,172 @@
+/**
+ * @file dmx.h
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LINUX_DMX_H_
+#define LINUX_DMX_H_
+
+/**
+ * Host backend with the same API as gd32/dmx.h.
+ * The USART, TIMER and DMA are replaced by a simulated wire running on
+ * virtual microsecond time, see linux/dmx_simulation.h
+ */
+
+#include <cstdint>
+
+#include "dmxconst.h"
+#include "dmxstatistics.h"
+
+#if !defined(DMX_MAX_PORTS)
+#define DMX_MAX_PORTS 4
+#endif
+
+static_assert(DMX_MAX_PORTS <= 8, "Too many ports defined");
+
+namespace dmx::config::max {
+inline constexpr uint32_t kPorts = DMX_MAX_PORTS;
+} // namespace dmx::config::max
+
+namespace dmx::buffer {
+static constexpr auto kSize = 516;
+} // namespace dmx::buffer
+static_assert(dmx::buffer::kSize >= 513);   // 512 with Start Code
+static_assert(dmx::buffer::kSize % 4 == 0); // multiple of uint32_t
+
+struct Statistics {
+    uint32_t slots_in_packet;
+};
+
+struct Data {
+    uint8_t data[dmx::buffer::kSize];
+    struct Statistics statistics;
+};
+
+class Dmx {
+   public:
+    Dmx();
+
+    void SetPortDirection(uint32_t port_index, dmx::Direction port_direction, bool enable_data = false);
+
+    template <uint32_t port_index, dmx::Direction port_direction, bool enable_data>
+    void SetPortDirection() {
+        static_assert(port_index < dmx::config::max::kPorts);
+        SetPortDirection(port_index, port_direction, enable_data);
+    }
+
+    [[nodiscard]] dmx::Direction PortDirection(uint32_t port_index) const { return port_direction_[port_index]; }
+
+    void ClearData(uint32_t port_index);
+
+    volatile dmx::TotalStatistics& GetTotalStatistics(uint32_t port_index);
+
+    // DMX Transmit
+    // The timing is per port. The functions without port_index apply to all ports.
+    void SetTransmitBreakTime(uint32_t port_index, uint32_t break_time);
+    void SetTransmitBreakTime(uint32_t break_time);
+    [[nodiscard]] uint32_t TransmitBreakTime(uint32_t port_index = 0) const;
+
+    void SetTransmitMabTime(uint32_t port_index, uint32_t mab_time);
+    void SetTransmitMabTime(uint32_t mab_time);
+    [[nodiscard]] uint32_t TransmitMabTime(uint32_t port_index = 0) const;
+
+    void SetTransmitPeriodTime(uint32_t port_index, uint32_t period_time);
+    void SetTransmitPeriodTime(uint32_t period_time);
+    [[nodiscard]] uint32_t TransmitPeriodTime(uint32_t port_index = 0) const;
+
+    void SetTransmitSlots(uint32_t port_index, uint16_t slots);
+    void SetTransmitSlots(uint16_t slots = dmx::kChannelsMax);
+    [[nodiscard]] uint16_t TransmitSlots(uint32_t port_index = 0) const;
+
+    template <dmx::SendStyle dmxSendStyle>
+    void SetTransmitDataWithSC(uint32_t port_index, const uint8_t* data, uint32_t length) {
+        SetSendDataInternal(port_index, true, dmxSendStyle, data, length);
+    }
+
+    template <dmx::SendStyle dmxSendStyle>
+    void SetTransmitDataWithoutSC(uint32_t port_index, const uint8_t* data, uint32_t length) {
+        SetSendDataInternal(port_index, false, dmxSendStyle, data, length);
+    }
+
+    void Sync();
+
+    void SetOutputStyle(uint32_t port_index, dmx::OutputStyle output_style);
+    [[nodiscard]] dmx::OutputStyle GetOutputStyle(uint32_t port_index) const;
+
+    void Blackout();
+    void FullOn();
+
+    // DMX Receive
+    const uint8_t* GetDmxAvailable(uint32_t port_index);
+    const uint8_t* GetDmxChanged(uint32_t port_index);
+    const uint8_t* GetDmxChanged(uint32_t port_index, dmx::ChangedSlots& changed);
+    /**
+     * Compares the current data with the data of the previous call, one word at a time.
+     * Only the slots in the packet are compared. To be used after GetDmxAvailable.
+     * @return true when changed is valid
+     */
+    bool GetDmxChangedSlots(uint32_t port_index, dmx::ChangedSlots& changed);
+    const uint8_t* GetDmxCurrentData(uint32_t port_index);
+
+    uint32_t GetDmxUpdatesPerSecond(uint32_t port_index);
+    /**
+     * @return false when no frame has been measured yet
+     */
+    bool GetDmxReceiveTiming(uint32_t port_index, dmx::ReceiveTiming& receive_timing);
+
+    // RDM Send
+    void RdmTransmit(uint32_t port_index, const uint8_t* data, uint32_t length);
+    void RdmTransmitDiscoveryRespondMessage(uint32_t port_index, const uint8_t* data, uint32_t length);
+
+    // RDM Receive
+    const uint8_t* RdmReceive(uint32_t port_index);
+    /**
+     * @param length the number of bytes received, including a discovery response without BREAK
+     */
+    const uint8_t* RdmReceive(uint32_t port_index, uint32_t& length);
+    const uint8_t* RdmReceiveTimeOut(uint32_t port_index, uint16_t timeout_ms);
+
+    static Dmx* Get() { return s_this; }
+
+   private:
+    void DataEnable(uint32_t port_index);
+    void DataDisable(uint32_t port_index);
+
+    void SetSendDataInternal(uint32_t port_index, bool has_start_code, dmx::SendStyle send_style, const uint8_t* data, uint32_t length);
+
+    void StartSendStyleDirect(uint32_t port_index);
+    void StartDmxOutput(uint32_t port_index);
+
+    void StartRdmOutput(uint32_t port_index);
+
+    uint32_t transmit_period_[dmx::config::max::kPorts];
+    uint32_t transmit_period_requested_[dmx::config::max::kPorts];
+    uint32_t transmit_length_[dmx::config::max::kPorts];
+    uint16_t transmit_slots_[dmx::config::max::kPorts];
+    dmx::Direction port_direction_[dmx::config::max::kPorts];
+    bool has_continuous_output_{false};
+
+    inline static Dmx* s_this;
+};
+
+#endif // LINUX_DMX_H_
@@ -0,0 +1,62 @@
+/**
+ * @file dmx_simulation.h
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LINUX_DMX_SIMULATION_H_
+#define LINUX_DMX_SIMULATION_H_
+
+#include <cstdint>
+
+#include "dmxconst.h"
+
+/**
+ * The simulated wire. Nothing happens until virtual time is advanced.
+ * Receive events are queued per port and delivered to the same state machine
+ * as the GD32 USART interrupt handler. Transmit runs the break/MAB/data/inter
+ * sequence of the GD32 TIMER1/TIMER4 interrupt handlers.
+ */
+
+namespace dmx::simulation {
+/// Called when a complete DMX or RDM packet has been put on the wire (including the start code).
+using TransmitCallback = void (*)(uint32_t port_index, const uint8_t* data, uint32_t length, uint64_t micros);
+
+void SetTransmitCallback(TransmitCallback transmit_callback);
+
+[[nodiscard]] uint64_t Micros();
+/// Advance virtual time and run all timer and wire events which are due.
+void Advance(uint32_t micros);
+/// Advance virtual time until all queued receive events have been delivered.
+void Drain(uint32_t port_index);
+
+/**
+ * Queue a DMX/RDM packet (data[0] is the start code) with break and MAB.
+ * The packet is appended after the already queued traffic.
+ * @return false when the receive queue is full
+ */
+bool ReceivePacket(uint32_t port_index, const uint8_t* data, uint32_t length, uint32_t break_time = dmx::transmit::kBreakTimeTypical, uint32_t mab_time = dmx::transmit::kMabTimeMin);
+/// Queue bytes without break, as used by a discovery response.
+bool ReceiveBytes(uint32_t port_index, const uint8_t* data, uint32_t length);
+} // namespace dmx::simulation
+
+#endif // LINUX_DMX_SIMULATION_H_
@@ -26,6 +26,19 @@
 #error
 #endif // defined(CONFIG_TIMER6_HAVE_NO_IRQ_HANDLER)
 
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+#if defined(CONFIG_DMX_TRANSMIT_ONLY)
+#error CONFIG_DMX_RECEIVE_DMA and CONFIG_DMX_TRANSMIT_ONLY are mutually exclusive
+#endif // defined(CONFIG_DMX_TRANSMIT_ONLY)
+#if !defined(GD32F10X)
+// Only gd32f10x_mcu.h defines the U(S)ARTx_RX_DMA_CHx channels
+#error CONFIG_DMX_RECEIVE_DMA is only supported for GD32F10X
+#endif // !defined(GD32F10X)
+#if defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
+#error CONFIG_DMX_RECEIVE_DMA: UART4 has no DMA
+#endif // defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
+
 #if !defined(CONFIG_DMX_NO_OPTIMIZE)
 #pragma GCC push_options
 #pragma GCC optimize("O3")
@@ -63,6 +76,7 @@ namespace dmx {
 namespace {
 constexpr uint32_t kDmxSlotsCompleteFlag = 0x8000;
 constexpr uint32_t kRdmSlotsCompleteFlag = 0x4000;
+constexpr uint32_t kRdmDiscoveryResponseSize = 24;
 
 enum class TxRxState { kIdle, kDmxBreak, kDmxMab, kDmxData, kDmxInter, kRdmData, kRdmChecksumh, kRdmChecksuml, kRdmdisc };
 enum class RdmTxState { kIdle, kBreak, kMab, kData, kDirection };
@@ -112,6 +126,18 @@ struct RxDmxPackets {
     uint32_t count_previous;
 };
 
+struct RxTiming {
+    uint32_t break_timestamp;
+    uint32_t start_code_timestamp;
+    uint32_t frames;
+    struct Last {
+        uint32_t break_timestamp;
+        uint32_t start_code_timestamp;
+        uint32_t end_timestamp;
+        uint8_t start_code;
+    } last;
+};
+
 struct RxDmxData {
     uint8_t data[dmx::buffer::kSize] ALIGNED;
     uint32_t slots_in_packet;
@@ -191,9 +217,14 @@ volatile dmx::TotalStatistics sv_total_statistics[dmx::config::max::kPorts] ALIG
 volatile dmx::RxDmxPackets sv_rx_dmx_packets[dmx::config::max::kPorts] ALIGNED;
 // DMX RDM RX
 volatile dmx::RxData sv_rx_buffer[dmx::config::max::kPorts] ALIGNED;
+volatile dmx::RxTiming sv_rx_timing[dmx::config::max::kPorts];
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+// Every frame is received here, on IDLE it is copied by START Code into the DMX or the RDM buffer
+uint8_t s_rx_dma_buffer[dmx::config::max::kPorts][dmx::buffer::kSize] ALIGNED SECTION_DMA_BUFFER;
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
 // DMX TX
 dmx::DmxTxData s_DmxTxBuffer[dmx::config::max::kPorts] ALIGNED SECTION_DMA_BUFFER;
-dmx::DmxTransmit s_dmx_transmit;
+dmx::DmxTransmit s_dmx_transmit[dmx::config::max::kPorts];
 // RDM TX
 dmx::RdmTxData s_RdmTxBuffer[dmx::config::max::kPorts] ALIGNED SECTION_DMA_BUFFER;
 } // namespace
@@ -201,6 +232,20 @@ dmx::RdmTxData s_RdmTxBuffer[dmx::config::max::kPorts] ALIGNED SECTION_DMA_BUFFE
 // RDM RX
 volatile uint32_t gsv_rdm_data_receive_end[dmx::config::max::kPorts];
 
+namespace {
+constexpr uint32_t kCyclesPerMicro = MCU_CLOCK_FREQ / 1000000U;
+constexpr uint32_t kSlotCycles = dmx::kSlotTime * kCyclesPerMicro;
+
+inline void RxTimingFrameEnd(uint32_t port_index, uint8_t start_code, uint32_t end_timestamp) {
+    auto& rx_timing = sv_rx_timing[port_index];
+    rx_timing.last.break_timestamp = rx_timing.break_timestamp;
+    rx_timing.last.start_code_timestamp = rx_timing.start_code_timestamp;
+    rx_timing.last.end_timestamp = end_timestamp;
+    rx_timing.last.start_code = start_code;
+    rx_timing.frames = rx_timing.frames + 1;
+}
+} // namespace
+
 template <uint32_t kUsartPeripheral>
 void IrqHandlerDmxRdmInput() {
     constexpr auto kPortIndex = GetPortByUart(kUsartPeripheral);
@@ -214,6 +259,8 @@ void IrqHandlerDmxRdmInput() {
         if (rx_buffer.state == dmx::TxRxState::kDmxData) {
             rx_buffer.state = dmx::TxRxState::kIdle;
             rx_buffer.dmx.current.slots_in_packet |= dmx::kDmxSlotsCompleteFlag;
+            // The IDLE is detected 1 slot time after the last received byte
+            RxTimingFrameEnd(kPortIndex, dmx::kStartCode, DWT->CYCCNT - kSlotCycles);
             return;
         }
 
@@ -235,6 +282,7 @@ void IrqHandlerDmxRdmInput() {
 
         if (rx_buffer.state == dmx::TxRxState::kIdle) {
             rx_buffer.state = dmx::TxRxState::kDmxBreak;
+            sv_rx_timing[kPortIndex].break_timestamp = DWT->CYCCNT;
         }
 
         return;
@@ -250,6 +298,7 @@ void IrqHandlerDmxRdmInput() {
             break;
 
         case dmx::TxRxState::kDmxBreak:
+            sv_rx_timing[kPortIndex].start_code_timestamp = DWT->CYCCNT;
             switch (kData) {
                 case dmx::kStartCode: {
                     rx_buffer.dmx.current.data[0] = dmx::kStartCode;
@@ -284,6 +333,7 @@ void IrqHandlerDmxRdmInput() {
                 index |= dmx::kDmxSlotsCompleteFlag;
                 rx_buffer.dmx.current.slots_in_packet = index;
                 rx_buffer.state = dmx::TxRxState::kIdle;
+                RxTimingFrameEnd(kPortIndex, dmx::kStartCode, DWT->CYCCNT);
                 break;
             }
         } break;
@@ -314,16 +364,19 @@ void IrqHandlerDmxRdmInput() {
         case dmx::TxRxState::kRdmChecksuml: {
             auto index = rx_buffer.rdm.index;
             rx_buffer.rdm.data[index] = kData;
+            index++; // The received length, including the checksum
             index |= dmx::kRdmSlotsCompleteFlag;
             rx_buffer.rdm.index = index;
             rx_buffer.state = dmx::TxRxState::kIdle;
-            gsv_rdm_data_receive_end[kPortIndex] = DWT->CYCCNT;
+            const auto kCycles = DWT->CYCCNT;
+            gsv_rdm_data_receive_end[kPortIndex] = kCycles;
+            RxTimingFrameEnd(kPortIndex, E120_SC_RDM, kCycles);
         } break;
 
         case dmx::TxRxState::kRdmdisc: {
             auto index = rx_buffer.rdm.index;
 
-            if (index < 24) { // TODO (a) Replace 24 with constepr
+            if (index < dmx::kRdmDiscoveryResponseSize) {
                 rx_buffer.rdm.data[index] = kData;
                 index++;
                 rx_buffer.rdm.index = index;
@@ -340,6 +393,125 @@ void IrqHandlerDmxRdmInput() {
     }
 }
 
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+/*
+ * The received slots are written by a circular DMA channel into s_rx_dma_buffer[].
+ * The USART interrupts only for the BREAK (frame error) and for IDLE (end of packet).
+ * A DMX frame is copied into sv_rx_buffer[].dmx, an RDM frame into sv_rx_buffer[].rdm,
+ * so that an RDM frame does not overwrite the last received DMX slots.
+ */
+template <uint32_t kDmaController, dma_channel_enum kDmaChannel>
+void DmaRestartRx(uint32_t port_index) {
+    auto dma_chctl = DMA_CHCTL(kDmaController, kDmaChannel);
+    // Disable channel
+    dma_chctl &= ~DMA_CHXCTL_CHEN;
+    DMA_CHCTL(kDmaController, kDmaChannel) = dma_chctl;
+    // Clear the full transfer finish flag, it is used for detecting a buffer wrap
+    Gd32DmaInterruptFlagClear<kDmaController, kDmaChannel, DMA_INTERRUPT_FLAG_CLEAR>();
+    // Restart at the beginning of the buffer
+    DMA_CHMADDR(kDmaController, kDmaChannel) = reinterpret_cast<uint32_t>(s_rx_dma_buffer[port_index]);
+    DMA_CHCNT(kDmaController, kDmaChannel) = static_cast<uint32_t>(dmx::buffer::kSize) & DMA_CHXCNT_CNT;
+    dma_chctl |= DMA_CHXCTL_CHEN;
+    DMA_CHCTL(kDmaController, kDmaChannel) = dma_chctl;
+}
+
+template <uint32_t kUsartPeripheral, uint32_t kDmaController, dma_channel_enum kDmaChannel>
+void IrqHandlerDmxRdmInputDma() {
+    constexpr auto kPortIndex = GetPortByUart(kUsartPeripheral);
+    auto& rx_buffer = sv_rx_buffer[kPortIndex];
+    const auto kIsFlagIdleFrame = (USART_REG_VAL(kUsartPeripheral, USART_FLAG_IDLE) & BIT(USART_BIT_POS(USART_FLAG_IDLE))) == BIT(USART_BIT_POS(USART_FLAG_IDLE));
+
+    // Software can clear this bit by reading the USART_STAT and USART_DATA registers one by one.
+    if (kIsFlagIdleFrame) {
+        static_cast<void>(GET_BITS(USART_RDATA(kUsartPeripheral), 0U, 8U));
+
+        const auto kIsWrapped = (DMA_INTF(kDmaController) & DMA_FLAG_ADD(DMA_FLAG_FTF, kDmaChannel)) != 0;
+        constexpr auto kBufferSize = static_cast<uint32_t>(dmx::buffer::kSize);
+        const auto kReceived = kIsWrapped ? kBufferSize : (kBufferSize - DMA_CHCNT(kDmaController, kDmaChannel));
+
+        if (kReceived == 0) [[unlikely]] {
+            // IDLE after the BREAK -> MAB is longer than 1 slot time
+            return;
+        }
+
+        const auto* data = s_rx_dma_buffer[kPortIndex];
+
+        if (rx_buffer.state == dmx::TxRxState::kDmxBreak) {
+            // The IDLE is detected 1 slot time after the last received byte.
+            // There is no interrupt for the start code, it is calculated without inter-slot time.
+            const auto kEndTimestamp = DWT->CYCCNT - kSlotCycles;
+            sv_rx_timing[kPortIndex].start_code_timestamp = kEndTimestamp - ((kReceived - 1) * kSlotCycles);
+            RxTimingFrameEnd(kPortIndex, data[0], kEndTimestamp);
+
+            switch (data[0]) {
+                case dmx::kStartCode: {
+                    const auto kSlots = (kReceived > dmx::kSlotsMax) ? dmx::kSlotsMax : kReceived;
+                    memcpy(const_cast<uint8_t*>(rx_buffer.dmx.current.data), data, kSlots);
+                    rx_buffer.dmx.current.slots_in_packet = kSlots | dmx::kDmxSlotsCompleteFlag;
+                    sv_rx_dmx_packets[kPortIndex].count = sv_rx_dmx_packets[kPortIndex].count + 1;
+                } break;
+
+                case E120_SC_RDM: {
+                    gsv_rdm_data_receive_end[kPortIndex] = kEndTimestamp;
+                    constexpr auto kRdmMessageSize = static_cast<uint32_t>(sizeof(struct TRdmMessage));
+                    // As in IrqHandlerDmxRdmInput, the message length is validated before the packet is accepted
+                    const auto kMessageLength = (kReceived > 2) ? static_cast<uint32_t>(data[2]) : 0;
+                    const auto kLength = kMessageLength + 2; // Including the checksum
+
+                    if ((kMessageLength < e120::kMessageLengthMin) || (kLength > kRdmMessageSize) || (kLength > kReceived)) [[unlikely]] {
+                        rx_buffer.rdm.index = 0;
+                        break;
+                    }
+
+                    for (uint32_t i = 0; i < kLength; i++) {
+                        rx_buffer.rdm.data[i] = data[i];
+                    }
+                    rx_buffer.rdm.index = kLength | dmx::kRdmSlotsCompleteFlag;
+                } break;
+
+                default:
+                    [[unlikely]] { rx_buffer.dmx.current.slots_in_packet = 0; }
+                    break;
+            }
+        } else if (rx_buffer.state == dmx::TxRxState::kIdle) {
+            // No BREAK -> Discovery response
+            const auto kLength = (kReceived > dmx::kRdmDiscoveryResponseSize) ? dmx::kRdmDiscoveryResponseSize : kReceived;
+            for (uint32_t i = 0; i < kLength; i++) {
+                rx_buffer.rdm.data[i] = data[i];
+            }
+            rx_buffer.rdm.index = kLength | dmx::kRdmSlotsCompleteFlag;
+        }
+
+        rx_buffer.state = dmx::TxRxState::kIdle;
+        DmaRestartRx<kDmaController, kDmaChannel>(kPortIndex);
+        return;
+    }
+
+    const auto kIsFlagFrameError = (USART_REG_VAL(kUsartPeripheral, USART_FLAG_FERR) & BIT(USART_BIT_POS(USART_FLAG_FERR))) == BIT(USART_BIT_POS(USART_FLAG_FERR));
+
+    // Software can clear this bit by reading the USART_STAT and USART_DATA registers one by one.
+    if (kIsFlagFrameError) {
+        static_cast<void>(GET_BITS(USART_RDATA(kUsartPeripheral), 0U, 8U));
+
+        if (rx_buffer.state == dmx::TxRxState::kIdle) {
+            // The BREAK byte is read above, the START Code will be the first byte in the buffer
+            DmaRestartRx<kDmaController, kDmaChannel>(kPortIndex);
+            rx_buffer.state = dmx::TxRxState::kDmxBreak;
+            sv_rx_timing[kPortIndex].break_timestamp = DWT->CYCCNT;
+        }
+
+        return;
+    }
+
+    // Overrun or noise error
+    static_cast<void>(GET_BITS(USART_RDATA(kUsartPeripheral), 0U, 8U));
+}
+
+#define IRQ_HANDLER_DMX_RDM_INPUT(USARTx, DMAx, CHx) IrqHandlerDmxRdmInputDma<USARTx, DMAx, CHx>()
+#else
+#define IRQ_HANDLER_DMX_RDM_INPUT(USARTx, DMAx, CHx) IrqHandlerDmxRdmInput<USARTx>()
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
+
 template <uint32_t kUsartPeripheral, uint32_t kDmaController, dma_channel_enum kDmaChannel>
 void DmaStartTx(const uint8_t* data, uint32_t length) {
     auto dma_chctl = DMA_CHCTL(kDmaController, kDmaChannel);
@@ -386,49 +558,49 @@ extern "C" {
 #if !defined(CONFIG_DMX_TRANSMIT_ONLY)
 #if defined(DMX_USE_USART0) || defined(DMX_USE_USART0_RX)
 void USART0_IRQHandler() {
-    IrqHandlerDmxRdmInput<USART0>();
+    IRQ_HANDLER_DMX_RDM_INPUT(USART0, USART0_DMAx, USART0_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_USART0) || defined(DMX_USE_USART0_RX)
 
 #if defined(DMX_USE_USART1) || defined(DMX_USE_USART1_RX)
 void USART1_IRQHandler() {
-    IrqHandlerDmxRdmInput<USART1>();
+    IRQ_HANDLER_DMX_RDM_INPUT(USART1, USART1_DMAx, USART1_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_USART1) || defined(DMX_USE_USART1_RX)
 
 #if defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
 void USART2_IRQHandler() {
-    IrqHandlerDmxRdmInput<USART2>();
+    IRQ_HANDLER_DMX_RDM_INPUT(USART2, USART2_DMAx, USART2_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
 
 #if defined(DMX_USE_UART3) || defined(DMX_USE_UART3_RX)
 void UART3_IRQHandler() {
-    IrqHandlerDmxRdmInput<UART3>();
+    IRQ_HANDLER_DMX_RDM_INPUT(UART3, UART3_DMAx, UART3_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_UART3) || defined(DMX_USE_UART3_RX)
 
 #if defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
 void UART4_IRQHandler() {
-    IrqHandlerDmxRdmInput<UART4>();
+    IRQ_HANDLER_DMX_RDM_INPUT(UART4, UART4_DMAx, UART4_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
 
 #if defined(DMX_USE_USART5) || defined(DMX_USE_USART5_RX)
 void USART5_IRQHandler() {
-    IrqHandlerDmxRdmInput<USART5>();
+    IRQ_HANDLER_DMX_RDM_INPUT(USART5, USART5_DMAx, USART5_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_USART5) || defined(DMX_USE_USART5_RX)
 
 #if defined(DMX_USE_UART6) || defined(DMX_USE_UART6_RX)
 void UART6_IRQHandler() {
-    IrqHandlerDmxRdmInput<UART6>();
+    IRQ_HANDLER_DMX_RDM_INPUT(UART6, UART6_DMAx, UART6_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_UART6) || defined(DMX_USE_UART6_RX)
 
 #if defined(DMX_USE_UART7) || defined(DMX_USE_UART7_RX)
 void UART7_IRQHandler() {
-    IrqHandlerDmxRdmInput<UART7>();
+    IRQ_HANDLER_DMX_RDM_INPUT(UART7, UART7_DMAx, UART7_RX_DMA_CHx);
 }
 #endif // defined(DMX_USE_UART7) || defined(DMX_USE_UART7_RX)
 #endif // !defined(CONFIG_DMX_TRANSMIT_ONLY)
@@ -446,7 +618,7 @@ void TIMER1_IRQHandler() {
                         Gd32GpioModeOutput<USART0_GPIOx, USART0_TX_GPIO_PINx>();
                         GPIO_BC(USART0_GPIOx) = USART0_TX_GPIO_PINx;
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                        TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+                        TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
                     }
                     break;
 
@@ -454,7 +626,7 @@ void TIMER1_IRQHandler() {
                     [[likely]] {
                         Gd32GpioModeAf<USART0_GPIOx, USART0_TX_GPIO_PINx, USART0>();
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                        TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.mab_time;
+                        TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].mab_time;
                     }
                     break;
 
@@ -514,7 +686,7 @@ void TIMER1_IRQHandler() {
                         Gd32GpioModeOutput<USART1_GPIOx, USART1_TX_GPIO_PINx>();
                         GPIO_BC(USART1_GPIOx) = USART1_TX_GPIO_PINx;
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                        TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+                        TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
                     }
                     break;
 
@@ -522,7 +694,7 @@ void TIMER1_IRQHandler() {
                     [[likely]] {
                         Gd32GpioModeAf<USART1_GPIOx, USART1_TX_GPIO_PINx, USART1>();
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                        TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.mab_time;
+                        TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].mab_time;
                     }
                     break;
 
@@ -583,7 +755,7 @@ void TIMER1_IRQHandler() {
                         Gd32GpioModeOutput<USART2_GPIOx, USART2_TX_GPIO_PINx>();
                         GPIO_BC(USART2_GPIOx) = USART2_TX_GPIO_PINx;
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                        TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+                        TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
                     }
                     break;
 
@@ -591,7 +763,7 @@ void TIMER1_IRQHandler() {
                     [[likely]] {
                         Gd32GpioModeAf<USART2_GPIOx, USART2_TX_GPIO_PINx, USART2>();
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                        TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.mab_time;
+                        TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].mab_time;
                     }
                     break;
 
@@ -652,14 +824,14 @@ void TIMER1_IRQHandler() {
                         Gd32GpioModeOutput<UART3_GPIOx, UART3_TX_GPIO_PINx>();
                         GPIO_BC(UART3_GPIOx) = UART3_TX_GPIO_PINx;
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                        TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+                        TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
                     }
                     break;
                 case dmx::TxRxState::kDmxBreak:
                     [[likely]] {
                         Gd32GpioModeAf<UART3_GPIOx, UART3_TX_GPIO_PINx, UART3>();
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                        TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.mab_time;
+                        TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].mab_time;
                     }
                     break;
                 case dmx::TxRxState::kDmxMab:
@@ -724,7 +896,7 @@ void TIMER4_IRQHandler() {
                         Gd32GpioModeOutput<UART4_TX_GPIOx, UART4_TX_GPIO_PINx>();
                         GPIO_BC(UART4_TX_GPIOx) = UART4_TX_GPIO_PINx;
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                        TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+                        TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
                     }
                     break;
 
@@ -732,7 +904,7 @@ void TIMER4_IRQHandler() {
                     [[likely]] {
                         Gd32GpioModeAf<UART4_TX_GPIOx, UART4_TX_GPIO_PINx, UART4>();
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                        TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.mab_time;
+                        TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].mab_time;
                     }
                     break;
 
@@ -795,7 +967,7 @@ void TIMER4_IRQHandler() {
                         Gd32GpioModeOutput<USART5_GPIOx, USART5_TX_GPIO_PINx>();
                         GPIO_BC(USART5_GPIOx) = USART5_TX_GPIO_PINx;
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                        TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+                        TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
                     }
                     break;
 
@@ -803,7 +975,7 @@ void TIMER4_IRQHandler() {
                     [[likely]] {
                         Gd32GpioModeAf<USART5_GPIOx, USART5_TX_GPIO_PINx, USART5>();
                         s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                        TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.mab_time;
+                        TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].mab_time;
                     }
                     break;
 
@@ -864,12 +1036,12 @@ void TIMER4_IRQHandler() {
                     Gd32GpioModeOutput<UART6_GPIOx, UART6_TX_GPIO_PINx>();
                     GPIO_BC(UART6_GPIOx) = UART6_TX_GPIO_PINx;
                     s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                    TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+                    TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
                     break;
                 case dmx::TxRxState::kDmxBreak:
                     Gd32GpioModeAf<UART6_GPIOx, UART6_TX_GPIO_PINx, UART6>();
                     s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                    TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.mab_time;
+                    TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].mab_time;
                     break;
                 case dmx::TxRxState::kDmxMab: {
                     DMA_RESTART_DMX_TX(kPortIndex, UART6, UART6_DMAx, UART6_TX_DMA_CHx);
@@ -924,12 +1096,12 @@ void TIMER4_IRQHandler() {
                     Gd32GpioModeOutput<UART7_GPIOx, UART7_TX_GPIO_PINx>();
                     GPIO_BC(UART7_GPIOx) = UART7_TX_GPIO_PINx;
                     s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
-                    TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+                    TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
                     break;
                 case dmx::TxRxState::kDmxBreak:
                     Gd32GpioModeAf<UART7_GPIOx, UART7_TX_GPIO_PINx, UART7>();
                     s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxMab;
-                    TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.mab_time;
+                    TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].mab_time;
                     break;
                 case dmx::TxRxState::kDmxMab: {
                     DMA_RESTART_DMX_TX(kPortIndex, UART7, UART7_DMAx, UART7_TX_DMA_CHx);
@@ -1009,7 +1181,7 @@ void DMA1_Channel7_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.inter_time;
+                TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1035,7 +1207,7 @@ void DMA0_Channel3_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.inter_time;
+                TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1064,7 +1236,7 @@ void DMA0_Channel6_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.inter_time;
+                TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1093,7 +1265,7 @@ void DMA0_Channel3_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.inter_time;
+                TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1119,7 +1291,7 @@ void DMA0_Channel1_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.inter_time;
+                TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1149,7 +1321,7 @@ void DMA0_Channel4_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.inter_time;
+                TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1175,7 +1347,7 @@ void DMA1_Channel4_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.inter_time;
+                TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1205,7 +1377,7 @@ void DMA1_Channel3_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.inter_time;
+                TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1232,7 +1404,7 @@ void DMA0_Channel7_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.inter_time;
+                TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1264,7 +1436,7 @@ void DMA1_Channel6_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.inter_time;
+                TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1291,7 +1463,7 @@ void DMA1_Channel4_IRQHandler() {
             if (s_DmxTxBuffer[dmx::config::kUart6Port].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[dmx::config::kUart6Port].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.inter_time;
+                TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[dmx::config::kUart6Port].inter_time;
                 s_DmxTxBuffer[dmx::config::kUart6Port].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1319,7 +1491,7 @@ void DMA0_Channel1_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.inter_time;
+                TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1347,7 +1519,7 @@ void DMA1_Channel3_IRQHandler() {
             if (s_DmxTxBuffer[dmx::config::kUart7Port].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[dmx::config::kUart7Port].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.inter_time;
+                TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[dmx::config::kUart7Port].inter_time;
                 s_DmxTxBuffer[dmx::config::kUart7Port].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1373,7 +1545,7 @@ void DMA0_Channel0_IRQHandler() {
             if (s_DmxTxBuffer[kPortIndex].output_style == dmx::OutputStyle::kDelta) {
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kIdle;
             } else {
-                TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.inter_time;
+                TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].inter_time;
                 s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxInter;
             }
 #if !defined(CONFIG_DMX_DISABLE_STATISTICS)
@@ -1395,6 +1567,56 @@ void DMA0_Channel0_IRQHandler() {
 #endif // defined(DMX_USE_UART7)
 }
 
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+static void RxDmaStart(uint32_t port_index) {
+    switch (std::to_underlying(kDirGpio[port_index].uart)) {
+#if defined(DMX_USE_USART0) || defined(DMX_USE_USART0_RX)
+        case USART0:
+            DmaRestartRx<USART0_DMAx, USART0_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_USART0) || defined(DMX_USE_USART0_RX)
+#if defined(DMX_USE_USART1) || defined(DMX_USE_USART1_RX)
+        case USART1:
+            DmaRestartRx<USART1_DMAx, USART1_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_USART1) || defined(DMX_USE_USART1_RX)
+#if defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
+        case USART2:
+            DmaRestartRx<USART2_DMAx, USART2_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
+#if defined(DMX_USE_UART3) || defined(DMX_USE_UART3_RX)
+        case UART3:
+            DmaRestartRx<UART3_DMAx, UART3_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_UART3) || defined(DMX_USE_UART3_RX)
+#if defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
+        case UART4:
+            DmaRestartRx<UART4_DMAx, UART4_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
+#if defined(DMX_USE_USART5) || defined(DMX_USE_USART5_RX)
+        case USART5:
+            DmaRestartRx<USART5_DMAx, USART5_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_USART5) || defined(DMX_USE_USART5_RX)
+#if defined(DMX_USE_UART6) || defined(DMX_USE_UART6_RX)
+        case UART6:
+            DmaRestartRx<UART6_DMAx, UART6_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_UART6) || defined(DMX_USE_UART6_RX)
+#if defined(DMX_USE_UART7) || defined(DMX_USE_UART7_RX)
+        case UART7:
+            DmaRestartRx<UART7_DMAx, UART7_RX_DMA_CHx>(port_index);
+            break;
+#endif // defined(DMX_USE_UART7) || defined(DMX_USE_UART7_RX)
+        default:
+            [[unlikely]] assert(false && "switch");
+            break;
+    }
+}
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
+
 [[gnu::noinline]]
 void Dmx::SetPortDirection(uint32_t port_index, dmx::Direction port_direction, bool enable_data) {
     DMX_CHECK_PORT_INDEX_VOID(port_index);
@@ -1474,7 +1696,13 @@ void Dmx::DataEnable(uint32_t port_index) {
 
         gd32::UartInterruptFlagClear<USART_INT_FLAG_RBNE>(kUart);
         gd32::UartInterruptFlagClear<USART_INT_FLAG_IDLE>(kUart);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+        RxDmaStart(port_index);
+        USART_CTL2(kUart) |= USART_RECEIVE_DMA_ENABLE;
+        gd32::UartInterruptEnable<USART_INT_ERR>(kUart);
+#else
         gd32::UartInterruptEnable<USART_INT_RBNE>(kUart);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
         gd32::UartInterruptEnable<USART_INT_FLAG_IDLE>(kUart);
 
         sv_port_state[port_index] = dmx::PortState::kRx;
@@ -1511,7 +1739,12 @@ void Dmx::DataDisable(uint32_t port_index) {
     }
 
     if (port_direction_[port_index] == dmx::Direction::kInput) {
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+        gd32::UartInterruptDisable<USART_INT_ERR>(kUart);
+        USART_CTL2(kUart) &= ~USART_RECEIVE_DMA_ENABLE;
+#else
         gd32::UartInterruptDisable<USART_INT_RBNE>(kUart);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
         gd32::UartInterruptDisable<USART_INT_FLAG_IDLE>(kUart);
         sv_rx_buffer[port_index].state = dmx::TxRxState::kIdle;
         return;
@@ -1594,7 +1827,7 @@ void Dmx::SetSendDataInternal(const uint8_t* data, uint32_t length) {
 
     auto* dst_data = tx_buffer.dmx.data[kWriteIndex].data;
 
-    const auto kCappedLength = (length < transmit_slots_) ? length : transmit_slots_;
+    const auto kCappedLength = (length < transmit_slots_[kPortIndex]) ? length : transmit_slots_[kPortIndex];
     tx_buffer.dmx.data[kWriteIndex].length = kCappedLength + 1;
 
     tx_buffer.dmx.data_pending = true;
@@ -1608,7 +1841,7 @@ void Dmx::SetSendDataInternal(const uint8_t* data, uint32_t length) {
 
     if (kCappedLength != transmit_length_[kPortIndex]) {
         transmit_length_[kPortIndex] = kCappedLength;
-        SetTransmitPeriodTime(transmit_period_requested_);
+        SetTransmitPeriodTime(kPortIndex, transmit_period_requested_[kPortIndex]);
     }
 
     if constexpr (kSendStyle == dmx::SendStyle::kDirect) {
@@ -1644,7 +1877,7 @@ void StartDmxOutputBreak() {
         case USART0:
             Gd32GpioModeOutput<USART0_GPIOx, USART0_TX_GPIO_PINx>();
             GPIO_BC(USART0_GPIOx) = USART0_TX_GPIO_PINx;
-            TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+            TIMER_CH0CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -1653,7 +1886,7 @@ void StartDmxOutputBreak() {
         case USART1:
             Gd32GpioModeOutput<USART1_GPIOx, USART1_TX_GPIO_PINx>();
             GPIO_BC(USART1_GPIOx) = USART1_TX_GPIO_PINx;
-            TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+            TIMER_CH1CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -1662,7 +1895,7 @@ void StartDmxOutputBreak() {
         case USART2:
             Gd32GpioModeOutput<USART2_GPIOx, USART2_TX_GPIO_PINx>();
             GPIO_BC(USART2_GPIOx) = USART2_TX_GPIO_PINx;
-            TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+            TIMER_CH2CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -1671,7 +1904,7 @@ void StartDmxOutputBreak() {
         case UART3:
             Gd32GpioModeOutput<UART3_GPIOx, UART3_TX_GPIO_PINx>();
             GPIO_BC(UART3_GPIOx) = UART3_TX_GPIO_PINx;
-            TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit.break_time;
+            TIMER_CH3CV(TIMER1) = TIMER_CNT(TIMER1) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -1681,7 +1914,7 @@ void StartDmxOutputBreak() {
         case UART4:
             Gd32GpioModeOutput<UART4_TX_GPIOx, UART4_TX_GPIO_PINx>();
             GPIO_BC(UART4_TX_GPIOx) = UART4_TX_GPIO_PINx;
-            TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+            TIMER_CH0CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -1690,7 +1923,7 @@ void StartDmxOutputBreak() {
         case USART5:
             Gd32GpioModeOutput<USART5_GPIOx, USART5_TX_GPIO_PINx>();
             GPIO_BC(USART5_GPIOx) = USART5_TX_GPIO_PINx;
-            TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+            TIMER_CH1CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -1699,7 +1932,7 @@ void StartDmxOutputBreak() {
         case UART6:
             Gd32GpioModeOutput<UART6_GPIOx, UART6_TX_GPIO_PINx>();
             GPIO_BC(UART6_GPIOx) = UART6_TX_GPIO_PINx;
-            TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+            TIMER_CH2CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -1708,7 +1941,7 @@ void StartDmxOutputBreak() {
         case UART7:
             Gd32GpioModeOutput<UART7_GPIOx, UART7_TX_GPIO_PINx>();
             GPIO_BC(UART7_GPIOx) = UART7_TX_GPIO_PINx;
-            TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit.break_time;
+            TIMER_CH3CV(TIMER4) = TIMER_CNT(TIMER4) + s_dmx_transmit[kPortIndex].break_time;
             s_DmxTxBuffer[kPortIndex].state = dmx::TxRxState::kDmxBreak;
             return;
             break;
@@ -2019,45 +2252,91 @@ void Dmx::Sync() {
 }
 
 // DMX Receive
-const uint8_t* Dmx::GetDmxChanged([[maybe_unused]] uint32_t port_index) {
+static_assert(((dmx::buffer::kSize + dmx::kChangedBlockSlots - 1) / dmx::kChangedBlockSlots) <= 32, "ChangedSlots::blocks is too small");
+
+bool Dmx::GetDmxChangedSlots([[maybe_unused]] uint32_t port_index, [[maybe_unused]] dmx::ChangedSlots& changed) {
+    DMX_CHECK_PORT_INDEX_RET(port_index, false);
 #if !defined(CONFIG_DMX_TRANSMIT_ONLY)
-    const auto* __restrict__ available = GetDmxAvailable(port_index);
+    auto& rx_dmx = sv_rx_buffer[port_index].dmx;
 
-    if (available == nullptr) {
-        return nullptr;
-    }
+    const auto* __restrict__ src32 = reinterpret_cast<const volatile uint32_t*>(rx_dmx.current.data);
+    auto* __restrict__ dst32 = reinterpret_cast<volatile uint32_t*>(rx_dmx.previous.data);
 
-    const auto* __restrict__ src32 = reinterpret_cast<const volatile uint32_t*>(sv_rx_buffer[port_index].dmx.current.data);
-    auto* __restrict__ dst32 = reinterpret_cast<volatile uint32_t*>(sv_rx_buffer[port_index].dmx.previous.data);
+    const auto kSlotsInPacket = rx_dmx.current.slots_in_packet & ~dmx::kDmxSlotsCompleteFlag;
+    const auto kSlots = std::min(kSlotsInPacket + 1, static_cast<uint32_t>(dmx::buffer::kSize)); // Including the Start Code
+    const auto kWords = (kSlots + 3) / 4;
 
-    if (sv_rx_buffer[port_index].dmx.current.slots_in_packet != sv_rx_buffer[port_index].dmx.previous.slots_in_packet) {
-        sv_rx_buffer[port_index].dmx.previous.slots_in_packet = sv_rx_buffer[port_index].dmx.current.slots_in_packet;
+    if (rx_dmx.current.slots_in_packet != rx_dmx.previous.slots_in_packet) {
+        rx_dmx.previous.slots_in_packet = rx_dmx.current.slots_in_packet;
 
         for (size_t i = 0; i < dmx::buffer::kSize / 4; ++i) {
             dst32[i] = src32[i];
         }
 
-        return available;
+        const auto kBlocks = (kSlots + dmx::kChangedBlockSlots - 1) / dmx::kChangedBlockSlots;
+
+        changed.first = 0;
+        changed.last = kSlots - 1;
+        changed.blocks = (kBlocks == 32) ? UINT32_MAX : ((1U << kBlocks) - 1);
+        return true;
     }
 
-    bool is_changed = false;
+    // The bytes after the last slot are not part of the packet
+    const auto kTailBytes = kSlots & 3;
+    const auto kTailMask = (kTailBytes == 0) ? UINT32_MAX : ((1U << (kTailBytes * 8)) - 1);
 
-    for (size_t i = 0; i < dmx::buffer::kSize / 4; ++i) {
+    uint32_t blocks = 0;
+
+    for (uint32_t i = 0; i < kWords; ++i) {
         const auto kSrcValue = src32[i];
-        auto dst_value = dst32[i];
+        const auto kDstValue = dst32[i];
+
+        if (kSrcValue == kDstValue) [[likely]] {
+            continue;
+        }
 
-        if (kSrcValue != dst_value) {
-            dst32[i] = kSrcValue;
-            is_changed = true;
+        dst32[i] = kSrcValue;
+
+        auto diff = kSrcValue ^ kDstValue;
+
+        if (i == (kWords - 1)) {
+            diff &= kTailMask;
+            if (diff == 0) {
+                continue;
+            }
         }
+
+        // Little endian: slot i * 4 is in the lowest byte
+        if (blocks == 0) {
+            changed.first = (i * 4) + (static_cast<uint32_t>(__builtin_ctz(diff)) >> 3);
+        }
+
+        changed.last = (i * 4) + 3 - (static_cast<uint32_t>(__builtin_clz(diff)) >> 3);
+        blocks |= 1U << ((i * 4) / dmx::kChangedBlockSlots);
     }
 
-    return (is_changed ? available : nullptr);
+    changed.blocks = blocks;
+    return (blocks != 0);
 #else
-    return nullptr;
+    return false;
 #endif // !defined(CONFIG_DMX_TRANSMIT_ONLY)
 }
 
+const uint8_t* Dmx::GetDmxChanged(uint32_t port_index, dmx::ChangedSlots& changed) {
+    const auto* available = GetDmxAvailable(port_index);
+
+    if (available == nullptr) {
+        return nullptr;
+    }
+
+    return (GetDmxChangedSlots(port_index, changed) ? available : nullptr);
+}
+
+const uint8_t* Dmx::GetDmxChanged(uint32_t port_index) {
+    dmx::ChangedSlots changed;
+    return GetDmxChanged(port_index, changed);
+}
+
 const uint8_t* Dmx::GetDmxAvailable([[maybe_unused]] uint32_t port_index) {
     DMX_CHECK_PORT_INDEX_PTR(port_index);
 #if !defined(CONFIG_DMX_TRANSMIT_ONLY)
@@ -2090,6 +2369,36 @@ uint32_t Dmx::GetDmxUpdatesPerSecond([[maybe_unused]] uint32_t port_index) {
 #endif // !defined(CONFIG_DMX_TRANSMIT_ONLY)
 }
 
+bool Dmx::GetDmxReceiveTiming([[maybe_unused]] uint32_t port_index, [[maybe_unused]] dmx::ReceiveTiming& receive_timing) {
+    DMX_CHECK_PORT_INDEX_RET(port_index, false);
+#if !defined(CONFIG_DMX_TRANSMIT_ONLY)
+    auto& rx_timing = sv_rx_timing[port_index];
+    uint32_t frames;
+
+    // Read again when a frame has ended in between
+    do {
+        frames = rx_timing.frames;
+        receive_timing.break_timestamp = rx_timing.last.break_timestamp;
+        receive_timing.start_code_timestamp = rx_timing.last.start_code_timestamp;
+        receive_timing.end_timestamp = rx_timing.last.end_timestamp;
+        receive_timing.start_code = rx_timing.last.start_code;
+    } while (frames != rx_timing.frames);
+
+    if (frames == 0) {
+        return false;
+    }
+
+    receive_timing.break_mab_time = (receive_timing.start_code_timestamp - receive_timing.break_timestamp) / kCyclesPerMicro;
+    receive_timing.frame_time = (receive_timing.end_timestamp - receive_timing.start_code_timestamp) / kCyclesPerMicro;
+    receive_timing.break_age = (DWT->CYCCNT - receive_timing.break_timestamp) / kCyclesPerMicro;
+    receive_timing.frames = frames;
+
+    return true;
+#else
+    return false;
+#endif // !defined(CONFIG_DMX_TRANSMIT_ONLY)
+}
+
 // RDM Send Discovery Response Message
 void Dmx::RdmTransmitDiscoveryRespondMessage(uint32_t port_index, const uint8_t* data, uint32_t length) {
     DMX_CHECK_PORT_INDEX_VOID(port_index);
@@ -2129,12 +2438,19 @@ void Dmx::RdmTransmitDiscoveryRespondMessage(uint32_t port_index, const uint8_t*
 
 // RDM Receive
 const uint8_t* Dmx::RdmReceive(uint32_t port_index) {
+    uint32_t length;
+    return RdmReceive(port_index, length);
+}
+
+const uint8_t* Dmx::RdmReceive(uint32_t port_index, uint32_t& length) {
+    length = 0;
     DMX_CHECK_PORT_INDEX_PTR(port_index);
 
     if ((sv_rx_buffer[port_index].rdm.index & dmx::kRdmSlotsCompleteFlag) != dmx::kRdmSlotsCompleteFlag) {
         return nullptr;
     }
 
+    length = sv_rx_buffer[port_index].rdm.index & ~dmx::kRdmSlotsCompleteFlag;
     sv_rx_buffer[port_index].rdm.index = 0;
 
     const auto* data = const_cast<const uint8_t*>(sv_rx_buffer[port_index].rdm.data);
@@ -2259,81 +2575,131 @@ template void Dmx::SetSendDataInternal<7, false, dmx::SendStyle::kSync>(const ui
 #pragma GCC push_options
 #pragma GCC optimize("Os")
 // Configuration
+[[gnu::noinline]]
+void Dmx::SetTransmitBreakTime(uint32_t port_index, uint32_t break_time) {
+    DMX_CHECK_PORT_INDEX_VOID(port_index);
+
+    s_dmx_transmit[port_index].break_time = std::max(dmx::transmit::kBreakTimeMin, break_time);
+    SetTransmitPeriodTime(port_index, transmit_period_requested_[port_index]);
+}
+
 [[gnu::noinline]]
 void Dmx::SetTransmitBreakTime(uint32_t break_time) {
-    s_dmx_transmit.break_time = std::max(dmx::transmit::kBreakTimeMin, break_time);
-    SetTransmitPeriodTime(transmit_period_requested_);
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitBreakTime(port_index, break_time);
+    }
+}
+
+[[gnu::noinline]]
+uint32_t Dmx::TransmitBreakTime(uint32_t port_index) const {
+    DMX_CHECK_PORT_INDEX_RET(port_index, 0);
+
+    return s_dmx_transmit[port_index].break_time;
 }
 
 [[gnu::noinline]]
-uint32_t Dmx::TransmitBreakTime() const {
-    return s_dmx_transmit.break_time;
+void Dmx::SetTransmitMabTime(uint32_t port_index, uint32_t mab_time) {
+    DMX_CHECK_PORT_INDEX_VOID(port_index);
+
+    s_dmx_transmit[port_index].mab_time = std::max(dmx::transmit::kMabTimeMin, mab_time);
+    SetTransmitPeriodTime(port_index, transmit_period_requested_[port_index]);
 }
 
 [[gnu::noinline]]
 void Dmx::SetTransmitMabTime(uint32_t mab_time) {
-    s_dmx_transmit.mab_time = std::max(dmx::transmit::kMabTimeMin, mab_time);
-    SetTransmitPeriodTime(transmit_period_requested_);
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitMabTime(port_index, mab_time);
+    }
 }
 
 [[gnu::noinline]]
-uint32_t Dmx::TransmitMabTime() const {
-    return s_dmx_transmit.mab_time;
+uint32_t Dmx::TransmitMabTime(uint32_t port_index) const {
+    DMX_CHECK_PORT_INDEX_RET(port_index, 0);
+
+    return s_dmx_transmit[port_index].mab_time;
 }
 
+/**
+ * The period is calculated for this port only, based on its own slot count,
+ * break and MAB time. A port with 24 slots is not slowed down by a port sending 512 slots.
+ */
 [[gnu::noinline]]
-void Dmx::SetTransmitPeriodTime(uint32_t period) {
-    transmit_period_requested_ = period;
+void Dmx::SetTransmitPeriodTime(uint32_t port_index, uint32_t period) {
+    DMX_CHECK_PORT_INDEX_VOID(port_index);
 
-    auto length_max = s_DmxTxBuffer[0].dmx.data[0].length;
+    auto& transmit = s_dmx_transmit[port_index];
 
-    for (uint32_t port_index = 1; port_index < dmx::config::max::kPorts; port_index++) {
-        const auto kLength = s_DmxTxBuffer[port_index].dmx.data[0].length;
-        if (kLength > length_max) {
-            length_max = kLength;
-        }
-    }
+    transmit_period_requested_[port_index] = period;
+
+    const auto kLength = transmit_length_[port_index] + 1; // Including the Start Code
 
-    auto package_length_micro_seconds = s_dmx_transmit.break_time + s_dmx_transmit.mab_time + (length_max * dmx::kSlotTime);
+    auto package_length_micro_seconds = transmit.break_time + transmit.mab_time + (kLength * dmx::kSlotTime);
 
     // The GD32F4xx/GD32H7XX Timer 1 has a 32-bit counter
 #if defined(GD32F4XX) || defined(GD32H7XX)
 #else
     if (package_length_micro_seconds > (UINT16_MAX - dmx::kSlotTime)) {
-        s_dmx_transmit.break_time = std::min(dmx::transmit::kBreakTimeTypical, s_dmx_transmit.break_time);
-        s_dmx_transmit.mab_time = dmx::transmit::kMabTimeMin;
-        package_length_micro_seconds = s_dmx_transmit.break_time + s_dmx_transmit.mab_time + (length_max * dmx::kSlotTime);
+        transmit.break_time = std::min(dmx::transmit::kBreakTimeTypical, transmit.break_time);
+        transmit.mab_time = dmx::transmit::kMabTimeMin;
+        package_length_micro_seconds = transmit.break_time + transmit.mab_time + (kLength * dmx::kSlotTime);
     }
 #endif // defined(GD32F4XX) || defined(GD32H7XX)
 
     if (period != 0) {
         if (period < package_length_micro_seconds) {
-            transmit_period_ = std::max(dmx::transmit::kBreakToBreakTimeMin, package_length_micro_seconds + dmx::kSlotTime);
+            transmit_period_[port_index] = std::max(dmx::transmit::kBreakToBreakTimeMin, package_length_micro_seconds + dmx::kSlotTime);
         } else {
-            transmit_period_ = period;
+            transmit_period_[port_index] = period;
         }
     } else {
-        transmit_period_ = std::max(dmx::transmit::kBreakToBreakTimeMin, package_length_micro_seconds + dmx::kSlotTime);
+        transmit_period_[port_index] = std::max(dmx::transmit::kBreakToBreakTimeMin, package_length_micro_seconds + dmx::kSlotTime);
     }
 
-    s_dmx_transmit.inter_time = transmit_period_ - package_length_micro_seconds;
+    transmit.inter_time = transmit_period_[port_index] - package_length_micro_seconds;
 
-    DMX_DEBUG_PRINTF("period=%u, length_max=%u, transmit_period_=%u, package_length_micro_seconds=%u -> s_dmx_transmit.inter_time=%u", period, length_max, transmit_period_, package_length_micro_seconds, s_dmx_transmit.inter_time);
+    DMX_DEBUG_PRINTF("port_index=%u, period=%u, length=%u, transmit_period_=%u, package_length_micro_seconds=%u -> inter_time=%u", port_index, period, kLength, transmit_period_[port_index], package_length_micro_seconds, transmit.inter_time);
 }
 
 [[gnu::noinline]]
-void Dmx::SetTransmitSlots(uint16_t slots) {
+void Dmx::SetTransmitPeriodTime(uint32_t period) {
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitPeriodTime(port_index, period);
+    }
+}
+
+[[gnu::noinline]]
+uint32_t Dmx::TransmitPeriodTime(uint32_t port_index) const {
+    DMX_CHECK_PORT_INDEX_RET(port_index, 0);
+
+    return transmit_period_[port_index];
+}
+
+[[gnu::noinline]]
+void Dmx::SetTransmitSlots(uint32_t port_index, uint16_t slots) {
+    DMX_CHECK_PORT_INDEX_VOID(port_index);
+
     if ((slots >= 2) && (slots <= dmx::kChannelsMax)) {
-        transmit_slots_ = slots;
+        transmit_slots_[port_index] = slots;
+        transmit_length_[port_index] = static_cast<uint32_t>(slots);
 
-        for (uint32_t i = 0; i < dmx::config::max::kPorts; i++) {
-            transmit_length_[i] = static_cast<uint32_t>(slots);
-        }
+        SetTransmitPeriodTime(port_index, transmit_period_requested_[port_index]);
+    }
+}
 
-        SetTransmitPeriodTime(transmit_period_requested_);
+[[gnu::noinline]]
+void Dmx::SetTransmitSlots(uint16_t slots) {
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitSlots(port_index, slots);
     }
 }
 
+[[gnu::noinline]]
+uint16_t Dmx::TransmitSlots(uint32_t port_index) const {
+    DMX_CHECK_PORT_INDEX_RET(port_index, 0);
+
+    return transmit_slots_[port_index];
+}
+
 [[gnu::noinline]]
 void Dmx::SetOutputStyle(uint32_t port_index, dmx::OutputStyle output_style) {
     DMX_CHECK_PORT_INDEX_VOID(port_index);
@@ -2378,6 +2744,46 @@ dmx::OutputStyle Dmx::GetOutputStyle(uint32_t port_index) const {
 }
 
 // Setup
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+/*
+ * The receive channels are shared with other peripherals:
+ * USART2_RX with SPI0_TX (DMA0 CH2) and UART3_RX with TIMER7_CH0 (DMA1 CH2).
+ */
+#if defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
+#if defined(SPI_DMA_CHx)
+static_assert(!((SPI_DMAx == USART2_DMAx) && (SPI_DMA_CHx == USART2_RX_DMA_CHx)), "USART2_RX and SPI0_TX share a DMA channel");
+#endif // defined(SPI_DMA_CHx)
+#if defined(I2S_DMA_CHx)
+static_assert(!((I2S_DMAx == USART2_DMAx) && (I2S_DMA_CHx == USART2_RX_DMA_CHx)), "USART2_RX and I2S share a DMA channel");
+#endif // defined(I2S_DMA_CHx)
+#endif // defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
+
+template <uint32_t kUsartPeripheral, uint32_t kDmaController, dma_channel_enum kDmaChannel>
+static void UsartDmaRxConfig() {
+    DMA_PARAMETER_STRUCT dma_init_struct;
+
+    // An enabled channel is in use by another peripheral (i.e. TIMER7_CH0 on the UART3_RX channel)
+    assert((DMA_CHCTL(kDmaController, kDmaChannel) & DMA_CHXCTL_CHEN) == 0);
+
+    dma_deinit(kDmaController, kDmaChannel);
+    dma_init_struct.direction = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.memory_addr = 0; // Set by DmaRestartRx
+    dma_init_struct.memory_inc = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+    dma_init_struct.number = dmx::buffer::kSize;
+    dma_init_struct.periph_addr = reinterpret_cast<uint32_t>(&USART_RDATA(kUsartPeripheral));
+    dma_init_struct.periph_inc = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+    dma_init_struct.priority = DMA_PRIORITY_ULTRA_HIGH;
+    dma_init(kDmaController, kDmaChannel, &dma_init_struct);
+    dma_circulation_enable(kDmaController, kDmaChannel);
+    dma_memory_to_memory_disable(kDmaController, kDmaChannel);
+    Gd32DmaInterruptDisable<kDmaController, kDmaChannel, DMA_INTERRUPT_DISABLE>();
+}
+
+#define USART_DMA_RX_CONFIG(USARTx) UsartDmaRxConfig<USARTx, USARTx##_DMAx, USARTx##_RX_DMA_CHx>()
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
+
 static void UartDmxConfig(uint32_t usart_periph) {
     gd32::UartBegin(usart_periph, dmx::kBaudRate, gd32::kUartBits8, gd32::kUartParityNone, gd32::kUartStop2Bits);
 }
@@ -2774,12 +3180,14 @@ Dmx::Dmx() {
     assert(s_this == nullptr);
     s_this = this;
 
-    s_dmx_transmit.break_time = dmx::transmit::kBreakTimeTypical;
-    s_dmx_transmit.mab_time = dmx::transmit::kMabTimeMin;
-    s_dmx_transmit.inter_time = dmx::transmit::kPeriodDefault - s_dmx_transmit.break_time - s_dmx_transmit.mab_time - (dmx::kChannelsMax * dmx::kSlotTime) - dmx::kSlotTime;
-
     for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        s_dmx_transmit[port_index].break_time = dmx::transmit::kBreakTimeTypical;
+        s_dmx_transmit[port_index].mab_time = dmx::transmit::kMabTimeMin;
+        s_dmx_transmit[port_index].inter_time = dmx::transmit::kPeriodDefault - s_dmx_transmit[port_index].break_time - s_dmx_transmit[port_index].mab_time - (dmx::kChannelsMax * dmx::kSlotTime) - dmx::kSlotTime;
+        transmit_period_[port_index] = dmx::transmit::kPeriodDefault;
+        transmit_period_requested_[port_index] = dmx::transmit::kPeriodDefault;
         transmit_length_[port_index] = dmx::kChannelsMax;
+        transmit_slots_[port_index] = dmx::kChannelsMax;
         sv_rx_buffer[port_index].state = dmx::TxRxState::kIdle;
         s_DmxTxBuffer[port_index].state = dmx::TxRxState::kIdle;
 
@@ -2807,41 +3215,65 @@ Dmx::Dmx() {
 
 #if defined(DMX_USE_USART0) || defined(DMX_USE_USART0_RX)
     UartDmxConfig(USART0);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(USART0);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(USART0_IRQn, 0);
     NVIC_EnableIRQ(USART0_IRQn);
 #endif // defined(DMX_USE_USART0) || defined(DMX_USE_USART0_RX)
 #if defined(DMX_USE_USART1) || defined(DMX_USE_USART1_RX)
     UartDmxConfig(USART1);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(USART1);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(USART1_IRQn, 0);
     NVIC_EnableIRQ(USART1_IRQn);
 #endif // defined(DMX_USE_USART1) || defined(DMX_USE_USART1_RX)
 #if defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
     UartDmxConfig(USART2);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(USART2);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(USART2_IRQn, 0);
     NVIC_EnableIRQ(USART2_IRQn);
 #endif // defined(DMX_USE_USART2) || defined(DMX_USE_USART2_RX)
 #if defined(DMX_USE_UART3) || defined(DMX_USE_UART3_RX)
     UartDmxConfig(UART3);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(UART3);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(UART3_IRQn, 0);
     NVIC_EnableIRQ(UART3_IRQn);
 #endif // defined(DMX_USE_UART3) || defined(DMX_USE_UART3_RX)
 #if defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
     UartDmxConfig(UART4);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(UART4);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(UART4_IRQn, 0);
     NVIC_EnableIRQ(UART4_IRQn);
 #endif // defined(DMX_USE_UART4) || defined(DMX_USE_UART4_RX)
 #if defined(DMX_USE_USART5) || defined(DMX_USE_USART5_RX)
     UartDmxConfig(USART5);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(USART5);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(USART5_IRQn, 0);
     NVIC_EnableIRQ(USART5_IRQn);
 #endif // defined(DMX_USE_USART5) || defined(DMX_USE_USART5_RX)
 #if defined(DMX_USE_UART6) || defined(DMX_USE_UART6_RX)
     UartDmxConfig(UART6);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(UART6);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(UART6_IRQn, 0);
     NVIC_EnableIRQ(UART6_IRQn);
 #endif // defined(DMX_USE_UART6) || defined(DMX_USE_UART6_RX)
 #if defined(DMX_USE_UART7) || defined(DMX_USE_UART7_RX)
     UartDmxConfig(UART7);
+#if defined(CONFIG_DMX_RECEIVE_DMA)
+    USART_DMA_RX_CONFIG(UART7);
+#endif // defined(CONFIG_DMX_RECEIVE_DMA)
     NVIC_SetPriority(UART7_IRQn, 0);
     NVIC_EnableIRQ(UART7_IRQn);
 #endif // defined(DMX_USE_UART7) || defined(DMX_USE_UART7_RX)
@@ -0,0 +1,1165 @@
+/**
+ * @file dmx.cpp
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "linux/dmx.h"
+#include "linux/dmx_simulation.h"
+#include "dmxconst.h"
+#include "e120.h"
+#include "rdmconst.h"
+#include "rdm_e120.h"
+#include "dmx_debug.h"
+
+namespace dmx {
+namespace {
+constexpr uint32_t kDmxSlotsCompleteFlag = 0x8000;
+constexpr uint32_t kRdmSlotsCompleteFlag = 0x4000;
+constexpr uint32_t kRdmDiscoveryResponseSize = 24;
+constexpr uint64_t kNever = UINT64_MAX;
+constexpr uint32_t kWireEventsSize = 2048; // Power of 2
+
+enum class TxRxState { kIdle, kDmxBreak, kDmxMab, kDmxData, kDmxInter, kRdmData, kRdmChecksumh, kRdmChecksuml, kRdmdisc };
+enum class RdmTxState { kIdle, kBreak, kMab, kData, kDirection };
+enum class PortState { kIdle, kTx, kRx };
+enum class WireEventType : uint8_t { kFrameError, kData, kIdle };
+
+struct DmxTxDataPacket {
+    uint8_t data[dmx::buffer::kSize];
+    uint32_t length;
+};
+
+struct DmxTxPacket {
+    DmxTxDataPacket data[2];
+    uint32_t write_index;
+    uint32_t read_index;
+    bool data_pending;
+};
+
+struct DmxTxData {
+    DmxTxPacket dmx;
+    OutputStyle output_style;
+    TxRxState state;
+};
+
+struct RdmTxDataPacket {
+    uint8_t data[sizeof(struct TRdmMessage)];
+    uint32_t length;
+};
+
+struct RdmTxData {
+    RdmTxDataPacket data;
+    RdmTxState state;
+};
+
+struct DmxTransmit {
+    uint32_t break_time;
+    uint32_t mab_time;
+    uint32_t inter_time;
+};
+
+struct RxDmxPackets {
+    uint32_t per_second;
+    uint32_t count;
+    uint32_t count_previous;
+};
+
+struct RxTiming {
+    uint32_t break_timestamp;
+    uint32_t start_code_timestamp;
+    uint32_t frames;
+    struct Last {
+        uint32_t break_timestamp;
+        uint32_t start_code_timestamp;
+        uint32_t end_timestamp;
+        uint8_t start_code;
+    } last;
+};
+
+struct RxDmxData {
+    uint8_t data[dmx::buffer::kSize];
+    uint32_t slots_in_packet;
+};
+
+struct RxData {
+    struct Dmx {
+        RxDmxData current;
+        RxDmxData previous;
+    } dmx;
+    struct Rdm {
+        uint8_t data[sizeof(struct TRdmMessage)];
+        uint32_t index;
+    } rdm;
+    TxRxState state;
+};
+
+// The simulated peripherals
+struct WireEvent {
+    uint64_t micros;
+    WireEventType type;
+    uint8_t data;
+};
+
+struct Wire {
+    WireEvent events[kWireEventsSize];
+    uint32_t head;
+    uint32_t tail;
+    uint64_t busy_until;
+};
+
+struct Channel {
+    uint64_t timer_compare; ///< TIMERx_CHxCV
+    uint64_t dma_complete;  ///< DMA full transfer finish
+    const uint8_t* dma_data;
+    uint32_t dma_length;
+};
+} // namespace
+} // namespace dmx
+
+namespace {
+dmx::PortState s_port_state[dmx::config::max::kPorts];
+
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+volatile dmx::TotalStatistics s_total_statistics[dmx::config::max::kPorts];
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+
+// DMX RX
+dmx::RxDmxPackets s_rx_dmx_packets[dmx::config::max::kPorts];
+// DMX RDM RX
+dmx::RxData s_rx_buffer[dmx::config::max::kPorts];
+dmx::RxTiming s_rx_timing[dmx::config::max::kPorts];
+// DMX TX
+dmx::DmxTxData s_DmxTxBuffer[dmx::config::max::kPorts];
+dmx::DmxTransmit s_dmx_transmit[dmx::config::max::kPorts];
+// RDM TX
+dmx::RdmTxData s_RdmTxBuffer[dmx::config::max::kPorts];
+
+// Simulation
+uint64_t s_micros;
+uint64_t s_next_second;
+dmx::Wire s_wire[dmx::config::max::kPorts];
+dmx::Channel s_channel[dmx::config::max::kPorts];
+dmx::simulation::TransmitCallback s_transmit_callback;
+} // namespace
+
+// RDM RX
+volatile uint32_t gsv_rdm_data_receive_end[dmx::config::max::kPorts];
+
+/*
+ * The simulation has no DWT, the timestamps are in virtual microseconds.
+ */
+static void RxTimingFrameEnd(uint32_t port_index, uint8_t start_code, uint32_t end_timestamp) {
+    auto& rx_timing = s_rx_timing[port_index];
+    rx_timing.last.break_timestamp = rx_timing.break_timestamp;
+    rx_timing.last.start_code_timestamp = rx_timing.start_code_timestamp;
+    rx_timing.last.end_timestamp = end_timestamp;
+    rx_timing.last.start_code = start_code;
+    rx_timing.frames++;
+}
+
+/*
+ * Mirrors IrqHandlerDmxRdmInput<>() from gd32/dmx.cpp
+ */
+static void IrqHandlerDmxRdmInput(uint32_t port_index, dmx::WireEventType type, uint8_t data) {
+    auto& rx_buffer = s_rx_buffer[port_index];
+
+    if (type == dmx::WireEventType::kIdle) {
+        if (rx_buffer.state == dmx::TxRxState::kDmxData) {
+            rx_buffer.state = dmx::TxRxState::kIdle;
+            rx_buffer.dmx.current.slots_in_packet |= dmx::kDmxSlotsCompleteFlag;
+            // The IDLE is detected 1 slot time after the last received byte
+            RxTimingFrameEnd(port_index, dmx::kStartCode, static_cast<uint32_t>(s_micros) - dmx::kSlotTime);
+            return;
+        }
+
+        if (rx_buffer.state == dmx::TxRxState::kRdmdisc) {
+            rx_buffer.state = dmx::TxRxState::kIdle;
+            rx_buffer.rdm.index |= dmx::kRdmSlotsCompleteFlag;
+            return;
+        }
+
+        return;
+    }
+
+    if (type == dmx::WireEventType::kFrameError) {
+        if (rx_buffer.state == dmx::TxRxState::kIdle) {
+            rx_buffer.state = dmx::TxRxState::kDmxBreak;
+            s_rx_timing[port_index].break_timestamp = static_cast<uint32_t>(s_micros);
+        }
+
+        return;
+    }
+
+    switch (rx_buffer.state) {
+        case dmx::TxRxState::kIdle:
+            rx_buffer.state = dmx::TxRxState::kRdmdisc;
+            rx_buffer.rdm.data[0] = data;
+            rx_buffer.rdm.index = 1;
+            break;
+
+        case dmx::TxRxState::kDmxBreak:
+            s_rx_timing[port_index].start_code_timestamp = static_cast<uint32_t>(s_micros);
+            switch (data) {
+                case dmx::kStartCode: {
+                    rx_buffer.dmx.current.data[0] = dmx::kStartCode;
+                    rx_buffer.dmx.current.slots_in_packet = 1;
+                    s_rx_dmx_packets[port_index].count++;
+                    rx_buffer.state = dmx::TxRxState::kDmxData;
+                } break;
+
+                case E120_SC_RDM: {
+                    rx_buffer.rdm.data[0] = E120_SC_RDM;
+                    rx_buffer.rdm.index = 1;
+                    rx_buffer.state = dmx::TxRxState::kRdmData;
+                } break;
+
+                default:
+                    rx_buffer.dmx.current.slots_in_packet = 0;
+                    rx_buffer.rdm.index = 0;
+                    rx_buffer.state = dmx::TxRxState::kIdle;
+                    break;
+            }
+            break;
+
+        case dmx::TxRxState::kDmxData: {
+            auto index = rx_buffer.dmx.current.slots_in_packet;
+            rx_buffer.dmx.current.data[index] = data;
+            index++;
+            rx_buffer.dmx.current.slots_in_packet = index;
+
+            if (index > dmx::kChannelsMax) {
+                index |= dmx::kDmxSlotsCompleteFlag;
+                rx_buffer.dmx.current.slots_in_packet = index;
+                rx_buffer.state = dmx::TxRxState::kIdle;
+                RxTimingFrameEnd(port_index, dmx::kStartCode, static_cast<uint32_t>(s_micros));
+                break;
+            }
+        } break;
+
+        case dmx::TxRxState::kRdmData: {
+            auto index = rx_buffer.rdm.index;
+            rx_buffer.rdm.data[index] = data;
+            index++;
+            rx_buffer.rdm.index = index;
+
+            const auto* message = reinterpret_cast<const struct TRdmMessage*>(&rx_buffer.rdm.data[0]);
+
+            if ((index >= e120::kMessageLengthMin) && (index <= sizeof(struct TRdmMessage)) && (index == message->message_length)) {
+                rx_buffer.state = dmx::TxRxState::kRdmChecksumh;
+            } else if (index > sizeof(struct TRdmMessage)) {
+                rx_buffer.state = dmx::TxRxState::kIdle;
+            }
+        } break;
+
+        case dmx::TxRxState::kRdmChecksumh: {
+            auto index = rx_buffer.rdm.index;
+            rx_buffer.rdm.data[index] = data;
+            index++;
+            rx_buffer.rdm.index = index;
+            rx_buffer.state = dmx::TxRxState::kRdmChecksuml;
+        } break;
+
+        case dmx::TxRxState::kRdmChecksuml: {
+            auto index = rx_buffer.rdm.index;
+            rx_buffer.rdm.data[index] = data;
+            index++; // The received length, including the checksum
+            index |= dmx::kRdmSlotsCompleteFlag;
+            rx_buffer.rdm.index = index;
+            rx_buffer.state = dmx::TxRxState::kIdle;
+            gsv_rdm_data_receive_end[port_index] = static_cast<uint32_t>(s_micros);
+            RxTimingFrameEnd(port_index, E120_SC_RDM, static_cast<uint32_t>(s_micros));
+        } break;
+
+        case dmx::TxRxState::kRdmdisc: {
+            auto index = rx_buffer.rdm.index;
+
+            if (index < dmx::kRdmDiscoveryResponseSize) {
+                rx_buffer.rdm.data[index] = data;
+                index++;
+                rx_buffer.rdm.index = index;
+            }
+        } break;
+
+        default:
+            rx_buffer.dmx.current.slots_in_packet = 0;
+            rx_buffer.rdm.index = 0;
+            rx_buffer.state = dmx::TxRxState::kIdle;
+            break;
+    }
+}
+
+static void DmaStartTx(uint32_t port_index, const uint8_t* data, uint32_t length) {
+    auto& channel = s_channel[port_index];
+    channel.dma_data = data;
+    channel.dma_length = length;
+    channel.dma_complete = s_micros + static_cast<uint64_t>(length) * dmx::kSlotTime;
+    channel.timer_compare = dmx::kNever;
+}
+
+static void DmaRestartDmxTx(uint32_t port_index) {
+    auto& dmx = s_DmxTxBuffer[port_index].dmx;
+
+    if (dmx.read_index != dmx.write_index) {
+        dmx.read_index ^= 1;
+    }
+
+    const auto& packet = dmx.data[dmx.read_index];
+
+    DmaStartTx(port_index, packet.data, packet.length);
+}
+
+/*
+ * Mirrors the per channel part of TIMER1_IRQHandler() / TIMER4_IRQHandler() from gd32/dmx.cpp
+ */
+static void TimerHandler(uint32_t port_index) {
+    auto& channel = s_channel[port_index];
+    channel.timer_compare = dmx::kNever;
+
+    if (s_DmxTxBuffer[port_index].state != dmx::TxRxState::kIdle) {
+        switch (s_DmxTxBuffer[port_index].state) {
+            case dmx::TxRxState::kDmxInter:
+                s_DmxTxBuffer[port_index].state = dmx::TxRxState::kDmxBreak;
+                channel.timer_compare = s_micros + s_dmx_transmit[port_index].break_time;
+                break;
+            case dmx::TxRxState::kDmxBreak:
+                s_DmxTxBuffer[port_index].state = dmx::TxRxState::kDmxMab;
+                channel.timer_compare = s_micros + s_dmx_transmit[port_index].mab_time;
+                break;
+            case dmx::TxRxState::kDmxMab:
+                DmaRestartDmxTx(port_index);
+                break;
+            default:
+                break;
+        }
+    } else if (s_RdmTxBuffer[port_index].state != dmx::RdmTxState::kIdle) {
+        switch (s_RdmTxBuffer[port_index].state) {
+            case dmx::RdmTxState::kBreak:
+                s_RdmTxBuffer[port_index].state = dmx::RdmTxState::kMab;
+                channel.timer_compare = s_micros + rdm::transmit::kMabTimeTypical;
+                break;
+            case dmx::RdmTxState::kMab:
+                s_RdmTxBuffer[port_index].state = dmx::RdmTxState::kData;
+                DmaStartTx(port_index, s_RdmTxBuffer[port_index].data.data, s_RdmTxBuffer[port_index].data.length);
+                break;
+            case dmx::RdmTxState::kDirection:
+                s_RdmTxBuffer[port_index].state = dmx::RdmTxState::kIdle;
+                s_port_state[port_index] = dmx::PortState::kIdle;
+                Dmx::Get()->SetPortDirection(port_index, dmx::Direction::kInput, true);
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+                s_total_statistics[port_index].rdm.sent.classes = s_total_statistics[port_index].rdm.sent.classes + 1;
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+                break;
+            default:
+                assert(false && "switch");
+                break;
+        }
+    }
+}
+
+/*
+ * Mirrors the DMAx_Channely_IRQHandler() functions from gd32/dmx.cpp
+ */
+static void DmaHandler(uint32_t port_index) {
+    auto& channel = s_channel[port_index];
+    channel.dma_complete = dmx::kNever;
+
+    if (s_transmit_callback != nullptr) {
+        s_transmit_callback(port_index, channel.dma_data, channel.dma_length, s_micros);
+    }
+
+    if (s_DmxTxBuffer[port_index].state != dmx::TxRxState::kIdle) {
+        if (s_DmxTxBuffer[port_index].output_style == dmx::OutputStyle::kDelta) {
+            s_DmxTxBuffer[port_index].state = dmx::TxRxState::kIdle;
+        } else {
+            channel.timer_compare = s_micros + s_dmx_transmit[port_index].inter_time;
+            s_DmxTxBuffer[port_index].state = dmx::TxRxState::kDmxInter;
+        }
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+        s_total_statistics[port_index].dmx.sent = s_total_statistics[port_index].dmx.sent + 1;
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+    } else if (s_RdmTxBuffer[port_index].state != dmx::RdmTxState::kIdle) {
+        channel.timer_compare = s_micros + rdm::transmit::kDirectionTime;
+        s_RdmTxBuffer[port_index].state = dmx::RdmTxState::kDirection;
+    }
+}
+
+/*
+ * Mirrors TIMER6_IRQHandler() from gd32/dmx.cpp
+ */
+static void SecondsHandler() {
+    for (uint32_t i = 0; i < dmx::config::max::kPorts; i++) {
+        auto& packet = s_rx_dmx_packets[i];
+        packet.per_second = packet.count - packet.count_previous;
+        packet.count_previous = packet.count;
+    }
+
+    s_next_second += 1000000U;
+}
+
+/*
+ * Run the first event which is due before or at the given time.
+ * Returns false when there is no such event.
+ */
+static bool RunNextEvent(uint64_t until) {
+    auto next = s_next_second;
+
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        const auto& channel = s_channel[port_index];
+        next = std::min({next, channel.timer_compare, channel.dma_complete});
+
+        const auto& wire = s_wire[port_index];
+        if (wire.head != wire.tail) {
+            next = std::min(next, wire.events[wire.tail].micros);
+        }
+    }
+
+    if (next > until) {
+        return false;
+    }
+
+    s_micros = next;
+
+    if (s_next_second == next) {
+        SecondsHandler();
+        return true;
+    }
+
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        auto& channel = s_channel[port_index];
+
+        if (channel.dma_complete == next) {
+            DmaHandler(port_index);
+            return true;
+        }
+
+        if (channel.timer_compare == next) {
+            TimerHandler(port_index);
+            return true;
+        }
+
+        auto& wire = s_wire[port_index];
+
+        if ((wire.head != wire.tail) && (wire.events[wire.tail].micros == next)) {
+            const auto& event = wire.events[wire.tail];
+            wire.tail = (wire.tail + 1) & (dmx::kWireEventsSize - 1);
+
+            // The receive interrupts are only enabled for an input port
+            if (s_port_state[port_index] == dmx::PortState::kRx) {
+                IrqHandlerDmxRdmInput(port_index, event.type, event.data);
+            }
+            return true;
+        }
+    }
+
+    assert(false && "Not reachable");
+    return false;
+}
+
+static bool WirePush(uint32_t port_index, uint64_t micros, dmx::WireEventType type, uint8_t data) {
+    auto& wire = s_wire[port_index];
+    const auto kNext = (wire.head + 1) & (dmx::kWireEventsSize - 1);
+
+    if (kNext == wire.tail) {
+        return false;
+    }
+
+    wire.events[wire.head] = {micros, type, data};
+    wire.head = kNext;
+    wire.busy_until = micros;
+
+    return true;
+}
+
+static uint32_t WireFree(uint32_t port_index) {
+    const auto& wire = s_wire[port_index];
+    return (wire.tail - wire.head - 1) & (dmx::kWireEventsSize - 1);
+}
+
+namespace dmx::simulation {
+void SetTransmitCallback(TransmitCallback transmit_callback) {
+    s_transmit_callback = transmit_callback;
+}
+
+uint64_t Micros() {
+    return s_micros;
+}
+
+void Advance(uint32_t micros) {
+    const auto kUntil = s_micros + micros;
+
+    while (RunNextEvent(kUntil)) {
+    }
+
+    s_micros = kUntil;
+}
+
+void Drain(uint32_t port_index) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    while (s_wire[port_index].head != s_wire[port_index].tail) {
+        RunNextEvent(kNever);
+    }
+}
+
+bool ReceivePacket(uint32_t port_index, const uint8_t* data, uint32_t length, uint32_t break_time, uint32_t mab_time) {
+    assert(port_index < dmx::config::max::kPorts);
+    assert(data != nullptr);
+
+    if (WireFree(port_index) < (length + 2)) {
+        return false;
+    }
+
+    auto micros = std::max(s_micros, s_wire[port_index].busy_until);
+    // The USART detects the frame error at the stop bit, 1 slot time after the BREAK has started
+    WirePush(port_index, micros + dmx::kSlotTime, WireEventType::kFrameError, 0);
+
+    micros += break_time + mab_time;
+
+    for (uint32_t i = 0; i < length; i++) {
+        micros += dmx::kSlotTime;
+        WirePush(port_index, micros, WireEventType::kData, data[i]);
+    }
+
+    return WirePush(port_index, micros + dmx::kSlotTime, WireEventType::kIdle, 0);
+}
+
+bool ReceiveBytes(uint32_t port_index, const uint8_t* data, uint32_t length) {
+    assert(port_index < dmx::config::max::kPorts);
+    assert(data != nullptr);
+
+    if (WireFree(port_index) < (length + 1)) {
+        return false;
+    }
+
+    auto micros = std::max(s_micros, s_wire[port_index].busy_until);
+
+    for (uint32_t i = 0; i < length; i++) {
+        micros += dmx::kSlotTime;
+        WirePush(port_index, micros, WireEventType::kData, data[i]);
+    }
+
+    return WirePush(port_index, micros + dmx::kSlotTime, WireEventType::kIdle, 0);
+}
+} // namespace dmx::simulation
+
+void Dmx::SetPortDirection(uint32_t port_index, dmx::Direction port_direction, bool enable_data) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    if (port_direction_[port_index] != port_direction) {
+        port_direction_[port_index] = port_direction;
+        DataDisable(port_index);
+    } else if (!enable_data) {
+        DataDisable(port_index);
+    }
+
+    if (enable_data) {
+        DataEnable(port_index);
+    }
+}
+
+void Dmx::DataEnable(uint32_t port_index) {
+    DMX_DEBUG_PRINTF("port_index=%u", port_index);
+    assert(port_index < dmx::config::max::kPorts);
+
+    if (port_direction_[port_index] == dmx::Direction::kOutput) {
+        s_port_state[port_index] = dmx::PortState::kTx;
+        s_DmxTxBuffer[port_index].state = dmx::TxRxState::kIdle;
+        SetOutputStyle(port_index, GetOutputStyle(port_index));
+        return;
+    }
+
+    if (port_direction_[port_index] == dmx::Direction::kInput) {
+        s_rx_buffer[port_index].state = dmx::TxRxState::kIdle;
+        s_port_state[port_index] = dmx::PortState::kRx;
+        return;
+    }
+}
+
+void Dmx::DataDisable(uint32_t port_index) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    if (s_port_state[port_index] == dmx::PortState::kIdle) {
+        return;
+    }
+
+    s_port_state[port_index] = dmx::PortState::kIdle;
+
+    if (port_direction_[port_index] == dmx::Direction::kOutput) {
+        // Let the packet on the wire finish, as the GD32 does by waiting for USART_FLAG_TC
+        while ((s_DmxTxBuffer[port_index].state != dmx::TxRxState::kIdle) && (s_DmxTxBuffer[port_index].state != dmx::TxRxState::kDmxInter)) {
+            if (!RunNextEvent(dmx::kNever)) {
+                break;
+            }
+        }
+
+        s_DmxTxBuffer[port_index].state = dmx::TxRxState::kIdle;
+        s_channel[port_index].timer_compare = dmx::kNever;
+        return;
+    }
+
+    if (port_direction_[port_index] == dmx::Direction::kInput) {
+        s_rx_buffer[port_index].state = dmx::TxRxState::kIdle;
+        return;
+    }
+}
+
+void Dmx::ClearData(uint32_t port_index) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    auto* data = &s_DmxTxBuffer[port_index].dmx.data[0];
+    data->length = dmx::kSlotsMax; // Including START Code
+    memset(data->data, 0, dmx::buffer::kSize);
+}
+
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+volatile dmx::TotalStatistics& Dmx::GetTotalStatistics(uint32_t port_index) {
+    s_total_statistics[port_index].dmx.received = s_rx_dmx_packets[port_index].count;
+    return s_total_statistics[port_index];
+}
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+
+void Dmx::Blackout() {
+    DMX_DEBUG_ENTRY();
+
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        if (port_direction_[port_index] == dmx::Direction::kOutput) {
+            DataDisable(port_index);
+            ClearData(port_index);
+            DataEnable(port_index);
+        }
+    }
+
+    DMX_DEBUG_EXIT();
+}
+
+void Dmx::FullOn() {
+    DMX_DEBUG_ENTRY();
+
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        if (port_direction_[port_index] == dmx::Direction::kOutput) {
+            DataDisable(port_index);
+
+            auto* data = &s_DmxTxBuffer[port_index].dmx.data[0];
+            memset(data->data, 0xFF, dmx::buffer::kSize);
+            data->data[0] = dmx::kStartCode;
+            data->length = dmx::kSlotsMax;
+
+            DataEnable(port_index);
+        }
+    }
+
+    DMX_DEBUG_EXIT();
+}
+
+// DMX Send
+void Dmx::SetSendDataInternal(uint32_t port_index, bool has_start_code, dmx::SendStyle send_style, const uint8_t* data, uint32_t length) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    auto& tx_buffer = s_DmxTxBuffer[port_index];
+    const auto kHasDataPending = tx_buffer.dmx.read_index != tx_buffer.dmx.write_index;
+
+    if (!kHasDataPending) {
+        // No pending data — switch to the other buffer
+        tx_buffer.dmx.write_index ^= 1;
+    }
+
+    const auto kWriteIndex = tx_buffer.dmx.write_index;
+
+    auto* dst_data = tx_buffer.dmx.data[kWriteIndex].data;
+
+    const auto kCappedLength = (length < transmit_slots_[port_index]) ? length : transmit_slots_[port_index];
+    tx_buffer.dmx.data[kWriteIndex].length = kCappedLength + 1;
+
+    tx_buffer.dmx.data_pending = true;
+
+    if (has_start_code) {
+        memcpy(dst_data, data, kCappedLength);
+    } else {
+        dst_data[0] = dmx::kStartCode;
+        memcpy(&dst_data[1], data, kCappedLength);
+    }
+
+    if (kCappedLength != transmit_length_[port_index]) {
+        transmit_length_[port_index] = kCappedLength;
+        SetTransmitPeriodTime(port_index, transmit_period_requested_[port_index]);
+    }
+
+    if (send_style == dmx::SendStyle::kDirect) {
+        StartSendStyleDirect(port_index);
+    }
+}
+
+void Dmx::StartSendStyleDirect(uint32_t port_index) {
+    if ((s_port_state[port_index] == dmx::PortState::kTx) && (s_DmxTxBuffer[port_index].output_style == dmx::OutputStyle::kDelta) && (s_DmxTxBuffer[port_index].state == dmx::TxRxState::kIdle)) {
+        StartDmxOutput(port_index);
+    }
+}
+
+void Dmx::StartDmxOutput(uint32_t port_index) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    // Wait for the transmission complete, the GD32 is polling USART_FLAG_TC
+    while (s_channel[port_index].dma_complete != dmx::kNever) {
+        RunNextEvent(dmx::kNever);
+    }
+
+    s_channel[port_index].timer_compare = s_micros + s_dmx_transmit[port_index].break_time;
+    s_DmxTxBuffer[port_index].state = dmx::TxRxState::kDmxBreak;
+}
+
+// DMX Output Synchronization
+void Dmx::Sync() {
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        auto& tx_buffer = s_DmxTxBuffer[port_index];
+
+        if (!tx_buffer.dmx.data_pending) {
+            continue;
+        }
+
+        tx_buffer.dmx.data_pending = false;
+
+        if (s_port_state[port_index] == dmx::PortState::kTx) {
+            if ((tx_buffer.output_style == dmx::OutputStyle::kDelta) && (tx_buffer.state == dmx::TxRxState::kIdle)) {
+                StartDmxOutput(port_index);
+            }
+        }
+    }
+}
+
+// RDM Send
+void Dmx::RdmTransmit(uint32_t port_index, const uint8_t* data, uint32_t length) {
+    assert(port_index < dmx::config::max::kPorts);
+    assert(data != nullptr);
+    assert(length <= sizeof(TRdmMessage));
+
+    SetPortDirection(port_index, dmx::Direction::kOutput, false);
+
+    auto& tx_buffer = s_RdmTxBuffer[port_index];
+    tx_buffer.data.length = length;
+    memcpy(tx_buffer.data.data, data, length);
+
+    StartRdmOutput(port_index);
+}
+
+void Dmx::StartRdmOutput(uint32_t port_index) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    while (s_channel[port_index].dma_complete != dmx::kNever) {
+        RunNextEvent(dmx::kNever);
+    }
+
+    s_channel[port_index].timer_compare = s_micros + rdm::transmit::kBreakTimeTypical;
+    s_RdmTxBuffer[port_index].state = dmx::RdmTxState::kBreak;
+}
+
+// DMX Receive
+bool Dmx::GetDmxChangedSlots(uint32_t port_index, dmx::ChangedSlots& changed) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    auto& dmx = s_rx_buffer[port_index].dmx;
+
+    const auto kSlotsInPacket = dmx.current.slots_in_packet & ~dmx::kDmxSlotsCompleteFlag;
+    const auto kSlots = std::min(kSlotsInPacket + 1, static_cast<uint32_t>(dmx::buffer::kSize)); // Including the Start Code
+    const auto kWords = (kSlots + 3) / 4;
+
+    if (dmx.current.slots_in_packet != dmx.previous.slots_in_packet) {
+        dmx.previous.slots_in_packet = dmx.current.slots_in_packet;
+        memcpy(dmx.previous.data, dmx.current.data, dmx::buffer::kSize);
+
+        const auto kBlocks = (kSlots + dmx::kChangedBlockSlots - 1) / dmx::kChangedBlockSlots;
+
+        changed.first = 0;
+        changed.last = kSlots - 1;
+        changed.blocks = (kBlocks == 32) ? UINT32_MAX : ((1U << kBlocks) - 1);
+        return true;
+    }
+
+    // The bytes after the last slot are not part of the packet
+    const auto kTailBytes = kSlots & 3;
+    const auto kTailMask = (kTailBytes == 0) ? UINT32_MAX : ((1U << (kTailBytes * 8)) - 1);
+
+    uint32_t blocks = 0;
+
+    for (uint32_t i = 0; i < kWords; ++i) {
+        uint32_t src_value;
+        uint32_t dst_value;
+        memcpy(&src_value, &dmx.current.data[i * 4], 4);
+        memcpy(&dst_value, &dmx.previous.data[i * 4], 4);
+
+        if (src_value == dst_value) {
+            continue;
+        }
+
+        memcpy(&dmx.previous.data[i * 4], &src_value, 4);
+
+        auto diff = src_value ^ dst_value;
+
+        if (i == (kWords - 1)) {
+            diff &= kTailMask;
+            if (diff == 0) {
+                continue;
+            }
+        }
+
+        // Little endian: slot i * 4 is in the lowest byte
+        if (blocks == 0) {
+            changed.first = (i * 4) + (static_cast<uint32_t>(__builtin_ctz(diff)) >> 3);
+        }
+
+        changed.last = (i * 4) + 3 - (static_cast<uint32_t>(__builtin_clz(diff)) >> 3);
+        blocks |= 1U << ((i * 4) / dmx::kChangedBlockSlots);
+    }
+
+    changed.blocks = blocks;
+    return (blocks != 0);
+}
+
+const uint8_t* Dmx::GetDmxChanged(uint32_t port_index, dmx::ChangedSlots& changed) {
+    const auto* available = GetDmxAvailable(port_index);
+
+    if (available == nullptr) {
+        return nullptr;
+    }
+
+    return (GetDmxChangedSlots(port_index, changed) ? available : nullptr);
+}
+
+const uint8_t* Dmx::GetDmxChanged(uint32_t port_index) {
+    dmx::ChangedSlots changed;
+    return GetDmxChanged(port_index, changed);
+}
+
+const uint8_t* Dmx::GetDmxAvailable(uint32_t port_index) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    auto slots_in_packet = s_rx_buffer[port_index].dmx.current.slots_in_packet;
+
+    if ((slots_in_packet & dmx::kDmxSlotsCompleteFlag) != dmx::kDmxSlotsCompleteFlag) {
+        return nullptr;
+    }
+
+    slots_in_packet &= ~dmx::kDmxSlotsCompleteFlag;
+    slots_in_packet--; // Remove SC from length
+    s_rx_buffer[port_index].dmx.current.slots_in_packet = slots_in_packet;
+
+    return s_rx_buffer[port_index].dmx.current.data;
+}
+
+const uint8_t* Dmx::GetDmxCurrentData(uint32_t port_index) {
+    return s_rx_buffer[port_index].dmx.current.data;
+}
+
+uint32_t Dmx::GetDmxUpdatesPerSecond(uint32_t port_index) {
+    assert(port_index < dmx::config::max::kPorts);
+    return s_rx_dmx_packets[port_index].per_second;
+}
+
+bool Dmx::GetDmxReceiveTiming(uint32_t port_index, dmx::ReceiveTiming& receive_timing) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    const auto& rx_timing = s_rx_timing[port_index];
+
+    if (rx_timing.frames == 0) {
+        return false;
+    }
+
+    receive_timing.break_timestamp = rx_timing.last.break_timestamp;
+    receive_timing.start_code_timestamp = rx_timing.last.start_code_timestamp;
+    receive_timing.end_timestamp = rx_timing.last.end_timestamp;
+    receive_timing.start_code = rx_timing.last.start_code;
+    receive_timing.break_mab_time = receive_timing.start_code_timestamp - receive_timing.break_timestamp;
+    receive_timing.frame_time = receive_timing.end_timestamp - receive_timing.start_code_timestamp;
+    receive_timing.break_age = static_cast<uint32_t>(s_micros) - receive_timing.break_timestamp;
+    receive_timing.frames = rx_timing.frames;
+
+    return true;
+}
+
+// RDM Send Discovery Response Message
+void Dmx::RdmTransmitDiscoveryRespondMessage(uint32_t port_index, const uint8_t* data, uint32_t length) {
+    assert(port_index < dmx::config::max::kPorts);
+    assert(data != nullptr);
+    assert(length != 0);
+
+    // 3.2.2 Responder Packet spacing
+    const auto kElapsed = static_cast<uint32_t>(s_micros) - gsv_rdm_data_receive_end[port_index];
+    if (kElapsed < rdm::responder::kPacketSpacing) {
+        dmx::simulation::Advance(rdm::responder::kPacketSpacing - kElapsed);
+    }
+
+    SetPortDirection(port_index, dmx::Direction::kOutput, false);
+
+    if (s_transmit_callback != nullptr) {
+        s_transmit_callback(port_index, data, length, s_micros);
+    }
+
+    dmx::simulation::Advance((length * dmx::kSlotTime) + rdm::responder::kDataDirectionDelay);
+
+    SetPortDirection(port_index, dmx::Direction::kInput, true);
+
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+    s_total_statistics[port_index].rdm.sent.discovery_response = s_total_statistics[port_index].rdm.sent.discovery_response + 1;
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+}
+
+// RDM Receive
+const uint8_t* Dmx::RdmReceive(uint32_t port_index) {
+    uint32_t length;
+    return RdmReceive(port_index, length);
+}
+
+const uint8_t* Dmx::RdmReceive(uint32_t port_index, uint32_t& length) {
+    length = 0;
+    assert(port_index < dmx::config::max::kPorts);
+
+    if ((s_rx_buffer[port_index].rdm.index & dmx::kRdmSlotsCompleteFlag) != dmx::kRdmSlotsCompleteFlag) {
+        return nullptr;
+    }
+
+    length = s_rx_buffer[port_index].rdm.index & ~dmx::kRdmSlotsCompleteFlag;
+    s_rx_buffer[port_index].rdm.index = 0;
+
+    const auto* data = s_rx_buffer[port_index].rdm.data;
+
+    if (data[0] == E120_SC_RDM) {
+        const auto* rdm_command = reinterpret_cast<const struct TRdmMessage*>(data);
+
+        uint32_t index;
+        uint16_t checksum = 0;
+
+        for (index = 0; index < rdm_command->message_length; index++) {
+            checksum = static_cast<uint16_t>(checksum + data[index]);
+        }
+
+        if ((data[index] == static_cast<uint8_t>(checksum >> 8)) && (data[index + 1] == static_cast<uint8_t>(checksum))) {
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+            s_total_statistics[port_index].rdm.received.good = s_total_statistics[port_index].rdm.received.good + 1;
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+            return data;
+        }
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+        s_total_statistics[port_index].rdm.received.bad = s_total_statistics[port_index].rdm.received.bad + 1;
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+        return nullptr;
+    }
+
+#if !defined(CONFIG_DMX_DISABLE_STATISTICS)
+    s_total_statistics[port_index].rdm.received.discovery_response = s_total_statistics[port_index].rdm.received.discovery_response + 1;
+#endif // !defined(CONFIG_DMX_DISABLE_STATISTICS)
+
+    return data;
+}
+
+// RDM Receive with timeout
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+const uint8_t* Dmx::RdmReceiveTimeOut(uint32_t port_index, uint16_t timeout_ms) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    const auto kTimeOut = s_micros + timeout_ms;
+
+    do {
+        const auto* data_available = RdmReceive(port_index);
+        if (data_available != nullptr) {
+            return data_available;
+        }
+        dmx::simulation::Advance(dmx::kSlotTime);
+    } while (s_micros < kTimeOut);
+
+    return nullptr;
+}
+
+// Configuration
+void Dmx::SetTransmitBreakTime(uint32_t port_index, uint32_t break_time) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    s_dmx_transmit[port_index].break_time = std::max(dmx::transmit::kBreakTimeMin, break_time);
+    SetTransmitPeriodTime(port_index, transmit_period_requested_[port_index]);
+}
+
+void Dmx::SetTransmitBreakTime(uint32_t break_time) {
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitBreakTime(port_index, break_time);
+    }
+}
+
+uint32_t Dmx::TransmitBreakTime(uint32_t port_index) const {
+    assert(port_index < dmx::config::max::kPorts);
+    return s_dmx_transmit[port_index].break_time;
+}
+
+void Dmx::SetTransmitMabTime(uint32_t port_index, uint32_t mab_time) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    s_dmx_transmit[port_index].mab_time = std::max(dmx::transmit::kMabTimeMin, mab_time);
+    SetTransmitPeriodTime(port_index, transmit_period_requested_[port_index]);
+}
+
+void Dmx::SetTransmitMabTime(uint32_t mab_time) {
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitMabTime(port_index, mab_time);
+    }
+}
+
+uint32_t Dmx::TransmitMabTime(uint32_t port_index) const {
+    assert(port_index < dmx::config::max::kPorts);
+    return s_dmx_transmit[port_index].mab_time;
+}
+
+void Dmx::SetTransmitPeriodTime(uint32_t port_index, uint32_t period) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    auto& transmit = s_dmx_transmit[port_index];
+
+    transmit_period_requested_[port_index] = period;
+
+    const auto kLength = transmit_length_[port_index] + 1; // Including the Start Code
+    const auto kPackageLengthMicroSeconds = transmit.break_time + transmit.mab_time + (kLength * dmx::kSlotTime);
+
+    if ((period != 0) && (period >= kPackageLengthMicroSeconds)) {
+        transmit_period_[port_index] = period;
+    } else {
+        transmit_period_[port_index] = std::max(dmx::transmit::kBreakToBreakTimeMin, kPackageLengthMicroSeconds + dmx::kSlotTime);
+    }
+
+    transmit.inter_time = transmit_period_[port_index] - kPackageLengthMicroSeconds;
+
+    DMX_DEBUG_PRINTF("port_index=%u, period=%u, length=%u, transmit_period_=%u, inter_time=%u", port_index, period, kLength, transmit_period_[port_index], transmit.inter_time);
+}
+
+void Dmx::SetTransmitPeriodTime(uint32_t period) {
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitPeriodTime(port_index, period);
+    }
+}
+
+uint32_t Dmx::TransmitPeriodTime(uint32_t port_index) const {
+    assert(port_index < dmx::config::max::kPorts);
+    return transmit_period_[port_index];
+}
+
+void Dmx::SetTransmitSlots(uint32_t port_index, uint16_t slots) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    if ((slots >= 2) && (slots <= dmx::kChannelsMax)) {
+        transmit_slots_[port_index] = slots;
+        transmit_length_[port_index] = static_cast<uint32_t>(slots);
+
+        SetTransmitPeriodTime(port_index, transmit_period_requested_[port_index]);
+    }
+}
+
+void Dmx::SetTransmitSlots(uint16_t slots) {
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        SetTransmitSlots(port_index, slots);
+    }
+}
+
+uint16_t Dmx::TransmitSlots(uint32_t port_index) const {
+    assert(port_index < dmx::config::max::kPorts);
+    return transmit_slots_[port_index];
+}
+
+void Dmx::SetOutputStyle(uint32_t port_index, dmx::OutputStyle output_style) {
+    assert(port_index < dmx::config::max::kPorts);
+
+    s_DmxTxBuffer[port_index].output_style = output_style;
+
+    if (output_style == dmx::OutputStyle::kConstant) {
+        if (!has_continuous_output_) {
+            has_continuous_output_ = true;
+            if (port_direction_[port_index] == dmx::Direction::kOutput) {
+                StartDmxOutput(port_index);
+            }
+            return;
+        }
+
+        for (uint32_t index = 0; index < dmx::config::max::kPorts; index++) {
+            if ((s_DmxTxBuffer[index].output_style == dmx::OutputStyle::kConstant) && (port_direction_[index] == dmx::Direction::kOutput)) {
+                DataDisable(index);
+            }
+        }
+
+        for (uint32_t index = 0; index < dmx::config::max::kPorts; index++) {
+            if ((s_DmxTxBuffer[index].output_style == dmx::OutputStyle::kConstant) && (port_direction_[index] == dmx::Direction::kOutput)) {
+                StartDmxOutput(index);
+            }
+        }
+    } else {
+        has_continuous_output_ = false;
+        for (uint32_t index = 0; index < dmx::config::max::kPorts; index++) {
+            if (s_DmxTxBuffer[index].output_style == dmx::OutputStyle::kConstant) {
+                has_continuous_output_ = true;
+                return;
+            }
+        }
+    }
+}
+
+dmx::OutputStyle Dmx::GetOutputStyle(uint32_t port_index) const {
+    assert(port_index < dmx::config::max::kPorts);
+    return s_DmxTxBuffer[port_index].output_style;
+}
+
+Dmx::Dmx() {
+    DMX_DEBUG_ENTRY();
+    assert(s_this == nullptr);
+    s_this = this;
+
+    s_micros = 0;
+    s_next_second = 1000000U;
+
+    for (uint32_t port_index = 0; port_index < dmx::config::max::kPorts; port_index++) {
+        s_channel[port_index].timer_compare = dmx::kNever;
+        s_channel[port_index].dma_complete = dmx::kNever;
+        s_wire[port_index].head = 0;
+        s_wire[port_index].tail = 0;
+        s_wire[port_index].busy_until = 0;
+
+        s_dmx_transmit[port_index].break_time = dmx::transmit::kBreakTimeTypical;
+        s_dmx_transmit[port_index].mab_time = dmx::transmit::kMabTimeMin;
+        transmit_period_requested_[port_index] = 0;
+        transmit_length_[port_index] = dmx::kChannelsMax;
+        transmit_slots_[port_index] = dmx::kChannelsMax;
+        port_direction_[port_index] = dmx::Direction::kDisable;
+        s_port_state[port_index] = dmx::PortState::kIdle;
+        s_rx_buffer[port_index].state = dmx::TxRxState::kIdle;
+        s_DmxTxBuffer[port_index].state = dmx::TxRxState::kIdle;
+        s_RdmTxBuffer[port_index].state = dmx::RdmTxState::kIdle;
+
+        SetPortDirection(port_index, dmx::Direction::kInput, false);
+        SetOutputStyle(port_index, dmx::OutputStyle::kDelta);
+        ClearData(port_index);
+    }
+
+    SetTransmitBreakTime(dmx::transmit::kBreakTimeTypical);
+    SetTransmitMabTime(dmx::transmit::kMabTimeMin);
+    SetTransmitSlots(dmx::kChannelsMax);
+    SetTransmitPeriodTime(0);
+
+    DMX_DEBUG_EXIT();
+}
@@ -0,0 +1,209 @@
+/**
+ * @file test_dmx_linux.cpp
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Host test of the Linux backend: the packets are put on the simulated wire
+ * and read back through the same API as used on the GD32.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "dmx.h"
+#include "linux/dmx_simulation.h"
+#include "e120.h"
+#include "rdm_e120.h"
+
+namespace {
+uint32_t s_failed;
+
+#define CHECK(condition)                                                         \
+    do {                                                                         \
+        if (!(condition)) {                                                      \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            s_failed++;                                                          \
+        }                                                                        \
+    } while (false)
+
+struct {
+    uint32_t port_index;
+    uint32_t length;
+    uint32_t count;
+    uint8_t data[dmx::buffer::kSize];
+} s_transmitted;
+
+void TransmitCallback(uint32_t port_index, const uint8_t* data, uint32_t length, [[maybe_unused]] uint64_t micros) {
+    s_transmitted.port_index = port_index;
+    s_transmitted.length = length;
+    s_transmitted.count++;
+    memcpy(s_transmitted.data, data, (length < sizeof(s_transmitted.data)) ? length : sizeof(s_transmitted.data));
+}
+
+void TestDmxReceive(Dmx& dmx) {
+    constexpr uint32_t kPortIndex = 0;
+    uint8_t packet[1 + 512];
+
+    packet[0] = dmx::kStartCode;
+    for (uint32_t i = 1; i < sizeof(packet); i++) {
+        packet[i] = static_cast<uint8_t>(i);
+    }
+
+    dmx.SetPortDirection(kPortIndex, dmx::Direction::kInput, true);
+
+    CHECK(dmx::simulation::ReceivePacket(kPortIndex, packet, sizeof(packet)));
+    dmx::simulation::Drain(kPortIndex);
+
+    dmx::ChangedSlots changed;
+    const auto* data = dmx.GetDmxChanged(kPortIndex, changed);
+
+    CHECK(data != nullptr);
+    if (data != nullptr) {
+        CHECK(memcmp(data, packet, sizeof(packet)) == 0);
+        CHECK(changed.first == 0);
+        CHECK(changed.last == 512);
+    }
+
+    dmx::ReceiveTiming receive_timing;
+    CHECK(dmx.GetDmxReceiveTiming(kPortIndex, receive_timing));
+    CHECK(receive_timing.start_code == dmx::kStartCode);
+    CHECK(receive_timing.break_mab_time >= (dmx::transmit::kBreakTimeTypical + dmx::transmit::kMabTimeMin));
+    CHECK(receive_timing.break_age >= (receive_timing.break_mab_time + receive_timing.frame_time));
+
+    // The same data again is not a change
+    CHECK(dmx::simulation::ReceivePacket(kPortIndex, packet, sizeof(packet)));
+    dmx::simulation::Drain(kPortIndex);
+    CHECK(dmx.GetDmxChanged(kPortIndex, changed) == nullptr);
+
+    // A single slot
+    packet[100] = static_cast<uint8_t>(~packet[100]);
+    CHECK(dmx::simulation::ReceivePacket(kPortIndex, packet, sizeof(packet)));
+    dmx::simulation::Drain(kPortIndex);
+    CHECK(dmx.GetDmxChanged(kPortIndex, changed) != nullptr);
+    CHECK(changed.first == 100);
+    CHECK(changed.last == 100);
+    CHECK(changed.blocks == (1U << (100 / dmx::kChangedBlockSlots)));
+
+    // A shorter packet is always reported
+    CHECK(dmx::simulation::ReceivePacket(kPortIndex, packet, 1 + 24));
+    dmx::simulation::Drain(kPortIndex);
+    CHECK(dmx.GetDmxChanged(kPortIndex, changed) != nullptr);
+    CHECK(changed.last == 24);
+}
+
+void TestDmxTransmit(Dmx& dmx) {
+    constexpr uint32_t kPortIndex = 1;
+    uint8_t data[512];
+
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<uint8_t>(0xFF - i);
+    }
+
+    dmx.SetPortDirection(kPortIndex, dmx::Direction::kOutput, true);
+    dmx.SetTransmitSlots(kPortIndex, 128);
+
+    s_transmitted.count = 0;
+    dmx.SetTransmitDataWithoutSC<dmx::SendStyle::kDirect>(kPortIndex, data, sizeof(data));
+    dmx::simulation::Advance(50000);
+
+    CHECK(s_transmitted.count == 1);
+    CHECK(s_transmitted.port_index == kPortIndex);
+    CHECK(s_transmitted.length == 1 + 128);
+    CHECK(s_transmitted.data[0] == dmx::kStartCode);
+    CHECK(memcmp(&s_transmitted.data[1], data, 128) == 0);
+
+    dmx.SetPortDirection(kPortIndex, dmx::Direction::kInput, false);
+}
+
+void TestRdmReceive(Dmx& dmx) {
+    constexpr uint32_t kPortIndex = 2;
+    TRdmMessage message;
+
+    memset(&message, 0, sizeof(message));
+    message.start_code = E120_SC_RDM;
+    message.sub_start_code = E120_SC_SUB_MESSAGE;
+    message.message_length = 24;
+    message.command_class = E120_GET_COMMAND;
+    message.param_id[0] = static_cast<uint8_t>(E120_DEVICE_INFO >> 8);
+    message.param_id[1] = static_cast<uint8_t>(E120_DEVICE_INFO);
+
+    auto* packet = reinterpret_cast<uint8_t*>(&message);
+    uint16_t checksum = 0;
+
+    for (uint32_t i = 0; i < message.message_length; i++) {
+        checksum = static_cast<uint16_t>(checksum + packet[i]);
+    }
+
+    packet[message.message_length] = static_cast<uint8_t>(checksum >> 8);
+    packet[message.message_length + 1] = static_cast<uint8_t>(checksum);
+
+    dmx.SetPortDirection(kPortIndex, dmx::Direction::kInput, true);
+
+    CHECK(dmx::simulation::ReceivePacket(kPortIndex, packet, message.message_length + 2U));
+    dmx::simulation::Drain(kPortIndex);
+
+    uint32_t length;
+    const auto* rdm = dmx.RdmReceive(kPortIndex, length);
+    CHECK(rdm != nullptr);
+    CHECK(length == message.message_length + 2U);
+    if (rdm != nullptr) {
+        CHECK(memcmp(rdm, packet, message.message_length + 2U) == 0);
+    }
+
+    // A bad checksum is rejected
+    packet[message.message_length + 1] = static_cast<uint8_t>(packet[message.message_length + 1] + 1);
+
+    CHECK(dmx::simulation::ReceivePacket(kPortIndex, packet, message.message_length + 2U));
+    dmx::simulation::Drain(kPortIndex);
+    CHECK(dmx.RdmReceive(kPortIndex) == nullptr);
+
+    // A truncated discovery response, no BREAK: the length is what was received
+    const uint8_t kResponse[] = {0xFE, 0xFE, 0xAA, 0xAA, 0x55};
+
+    CHECK(dmx::simulation::ReceiveBytes(kPortIndex, kResponse, sizeof(kResponse)));
+    dmx::simulation::Drain(kPortIndex);
+    rdm = dmx.RdmReceive(kPortIndex, length);
+    CHECK(rdm != nullptr);
+    CHECK(length == sizeof(kResponse));
+}
+} // namespace
+
+int main() {
+    Dmx dmx;
+
+    dmx::simulation::SetTransmitCallback(TransmitCallback);
+
+    TestDmxReceive(dmx);
+    TestDmxTransmit(dmx);
+    TestRdmReceive(dmx);
+
+    if (s_failed != 0) {
+        printf("%u check(s) failed\n", static_cast<unsigned>(s_failed));
+        return 1;
+    }
+
+    puts("All tests passed");
+    return 0;
+}
@@ -17,6 +17,12 @@ ifneq ($(MAKE_FLAGS),)
 	ifeq ($(findstring ARTNET_HAVE_FAILSAFE_RECORD,$(MAKE_FLAGS)), ARTNET_HAVE_FAILSAFE_RECORD)
 		EXTRA_SRCDIR+=src/scenes
 	endif
+	ifneq (,$(findstring ENABLE_RDM_PRESET_PLAYBACK,$(MAKE_FLAGS)))
+		EXTRA_INCLUDES+=../lib-rdm/include
+		ifeq (,$(findstring src/scenes,$(EXTRA_SRCDIR)))
+			EXTRA_SRCDIR+=src/scenes
+		endif
+	endif
 else
 	DEFINES+=NODE_ARTNET
 	DEFINES+=ARTNET_VERSION=4
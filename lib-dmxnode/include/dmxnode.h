@@ -31,6 +31,7 @@
 #include <cassert>
 
 #include "configurationstore.h"
+#include "softwaretimers.h"
 
 namespace dmxnode {
 inline constexpr uint16_t kAddressInvalid = 0xFFFF;
@@ -236,14 +237,55 @@ inline OutputStyle GetOutputStyle(const char* output_style) {
 }
 
 namespace scenes {
-inline constexpr auto kBytesNeeded = dmxnode::kMaxPorts * dmxnode::kUniverseSize;
+inline constexpr uint32_t kProgrammedOffset = dmxnode::kMaxPorts * dmxnode::kUniverseSize; ///< The marker follows the port data
+inline constexpr uint32_t kProgrammedMarker = 0x4E454353;                                  ///< "SCEN"
+inline constexpr uint32_t kBytesNeeded = kProgrammedOffset + static_cast<uint32_t>(sizeof(kProgrammedMarker));
+#if !defined(CONFIG_DMXNODE_SCENES_STEPS_PER_RUN)
+#define CONFIG_DMXNODE_SCENES_STEPS_PER_RUN 8
+#endif
+inline constexpr uint32_t kStepsPerRun = CONFIG_DMXNODE_SCENES_STEPS_PER_RUN; ///< Backend calls per SoftwareTimerRun()
+
+#if !defined(CONFIG_DMXNODE_SCENES)
+#if defined(ENABLE_RDM_PRESET_PLAYBACK)
+#define CONFIG_DMXNODE_SCENES 4
+#else
+#define CONFIG_DMXNODE_SCENES 0
+#endif
+#endif
+inline constexpr uint32_t kFailSafe = 0;                       ///< The scene recorded for fail-safe playback
+inline constexpr uint32_t kScenes = CONFIG_DMXNODE_SCENES;     ///< The numbered scenes 1..kScenes
+inline constexpr uint32_t kSlots = 1 + kScenes;
 
-void WriteStart();
-void Write(uint32_t port_index, const uint8_t* data);
+#if !defined(CONFIG_DMXNODE_SCENES_FRAME_MILLIS)
+#define CONFIG_DMXNODE_SCENES_FRAME_MILLIS 25
+#endif
+#if !defined(CONFIG_DMXNODE_SCENES_FADE_MILLIS)
+#define CONFIG_DMXNODE_SCENES_FADE_MILLIS 2000
+#endif
+#if !defined(CONFIG_DMXNODE_SCENES_HOLD_MILLIS)
+#define CONFIG_DMXNODE_SCENES_HOLD_MILLIS 5000
+#endif
+inline constexpr uint32_t kFrameMillis = CONFIG_DMXNODE_SCENES_FRAME_MILLIS; ///< Crossfade output frame interval
+inline constexpr uint32_t kFadeMillis = CONFIG_DMXNODE_SCENES_FADE_MILLIS;   ///< Default crossfade time
+inline constexpr uint32_t kHoldMillis = CONFIG_DMXNODE_SCENES_HOLD_MILLIS;   ///< Time a scene is shown in a sequence
+
+using Callback = void (*)();
+
+/**
+ * WriteStart and Write are non-blocking, each call does a bounded amount of erase/program work.
+ * @return true when done
+ */
+bool WriteStart(uint32_t scene);
+bool Write(uint32_t scene, uint32_t port_index, const uint8_t* data);
+/**
+ * Written after all ports, a scene without the marker is erased or was not stored completely.
+ */
+bool WriteProgrammed(uint32_t scene);
 void WriteEnd();
 
 void ReadStart();
-void Read(uint32_t port_index, uint8_t* data);
+void Read(uint32_t scene, uint32_t port_index, uint8_t* data);
+bool IsProgrammed(uint32_t scene);
 void ReadEnd();
 } // namespace scenes
 } // namespace dmxnode
@@ -280,10 +322,46 @@ class DmxNode {
         return port.label;
     }
 
-    void SceneStore();
+    /**
+     * Records the output ports as an asynchronous job, driven by a software timer.
+     * @param scene kFailSafe or 1..kScenes
+     * @param callback called when the scene is stored
+     * @return false when a store is already in progress or no software timer is available
+     */
+    bool SceneStore(uint32_t scene = dmxnode::scenes::kFailSafe, dmxnode::scenes::Callback callback = nullptr);
     void ScenePlayback();
+    [[nodiscard]] bool IsSceneStoreBusy() const;
+
+#if CONFIG_DMXNODE_SCENES > 0
+    /**
+     * Crossfades the output ports from their current values to scene 1..kScenes, scaled by level.
+     * The fade is computed per output frame. When the fade is done the scene is held until SceneFadeStop().
+     * The network input is not gated, the caller must stop forwarding network data to the output ports
+     * while IsScenePlaybackActive(), otherwise both write the same output buffers.
+     * @return false when the scene is not programmed or a scene store is in progress
+     */
+    bool SceneFade(uint32_t scene, uint8_t level);
+    /**
+     * Plays the programmed scenes of 1..kScenes in a loop, each with a crossfade followed by kHoldMillis.
+     * The same caller contract as SceneFade() applies.
+     * @return false when no scene is programmed or a scene store is in progress
+     */
+    bool SceneSequence(uint8_t level);
+    void SceneFadeStop();
+    /**
+     * @return true from SceneFade() or SceneSequence() until SceneFadeStop(), also while a faded in scene is held
+     */
+    [[nodiscard]] bool IsScenePlaybackActive() const;
+    void SetSceneFadeMillis(uint32_t fade_millis);
+#endif // CONFIG_DMXNODE_SCENES > 0
 
    private:
+#if CONFIG_DMXNODE_SCENES > 0
+    void SceneFadeStart(uint32_t scene, uint8_t level);
+    void SceneFadeRun();
+    static void SceneFadeTimer(TimerHandle_t timer_handle);
+#endif // CONFIG_DMXNODE_SCENES > 0
+
     DmxNode() {
         for (uint32_t i = 0; i < dmxnode::kMaxPorts; i++) {
             SetShortNameDefault(i);
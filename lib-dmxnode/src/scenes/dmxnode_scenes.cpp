@@ -24,28 +24,134 @@
  */
 
 #include <cstdint>
+#include <cstring>
+#include <cassert>
 
 #include "dmxnode.h"
 #include "dmxnodedata.h"
 #include "dmxnode_nodetype.h"
+#include "softwaretimers.h"
+#include "dmxnode_debug.h"
 
-void DmxNode::SceneStore() {
-    dmxnode::scenes::WriteStart();
+namespace dmxnode::scenes {
+enum class State { kIdle, kErasing, kWriting, kMarking };
 
-    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
-        assert(port_index < dmxnode::kMaxPorts);
-        auto& port = port_[port_index];
+static State s_state;
+static uint32_t s_scene;
+static uint32_t s_port_index;
+static uint32_t s_port_mask;
+static Callback s_callback;
+static TimerHandle_t s_timer_id = kTimerIdNone;
+/*
+ * The backend keeps the data pointer until the write is done, the backup
+ * is copied so that incoming DMX does not change it while it is programmed.
+ */
+alignas(4) static uint8_t s_data[dmxnode::kUniverseSize];
 
-        if (port.port_direction == dmxnode::Direction::kOutput) {
-            dmxnode::scenes::Write(port_index, dmxnode::Data::Backup(port_index));
+static void Done() {
+    WriteEnd();
+
+    SoftwareTimerDelete(s_timer_id);
+    s_state = State::kIdle;
+
+    DMXNODE_DEBUG_PUTS("Scene stored");
+
+    if (s_callback != nullptr) {
+        s_callback();
+    }
+}
+
+static void NextPort() {
+    while ((s_port_index < dmxnode::kMaxPorts) && ((s_port_mask & (1U << s_port_index)) == 0)) {
+        s_port_index++;
+    }
+
+    if (s_port_index < dmxnode::kMaxPorts) {
+        memcpy(s_data, dmxnode::Data::Backup(s_port_index), dmxnode::kUniverseSize);
+    }
+}
+
+/*
+ * Called from SoftwareTimerRun(). A flash erase or program is started and
+ * polled, but never waited for, so the superloop keeps running.
+ */
+static void Run([[maybe_unused]] TimerHandle_t timer_handle) {
+    for (uint32_t step = 0; step < kStepsPerRun; step++) {
+        switch (s_state) {
+            case State::kErasing:
+                if (WriteStart(s_scene)) {
+                    s_port_index = 0;
+                    NextPort();
+                    s_state = State::kWriting;
+                }
+                break;
+            case State::kWriting:
+                if (s_port_index == dmxnode::kMaxPorts) {
+                    s_state = State::kMarking;
+                    break;
+                }
+
+                if (Write(s_scene, s_port_index, s_data)) {
+                    s_port_index++;
+                    NextPort();
+                }
+                break;
+            case State::kMarking:
+                // The scene is marked as programmed only when all ports are written
+                if (WriteProgrammed(s_scene)) {
+                    Done();
+                    return;
+                }
+                break;
+            default:
+                assert(false && "switch");
+                return;
         }
     }
+}
+} // namespace dmxnode::scenes
 
-    dmxnode::scenes::WriteEnd();
+bool DmxNode::SceneStore(uint32_t scene, dmxnode::scenes::Callback callback) {
+    if (IsSceneStoreBusy() || (scene >= dmxnode::scenes::kSlots)) {
+        return false;
+    }
+
+    static_assert(dmxnode::kMaxPorts <= 32, "s_port_mask is a bit per port");
+
+    uint32_t port_mask = 0;
+
+    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+        if (port_[port_index].port_direction == dmxnode::Direction::kOutput) {
+            port_mask |= (1U << port_index);
+        }
+    }
+
+    // The timer is added first, without a free timer the store is not started at all
+    const auto kTimerId = SoftwareTimerAdd(0, dmxnode::scenes::Run);
+
+    if (kTimerId == kTimerIdNone) {
+        return false;
+    }
+
+    dmxnode::scenes::s_timer_id = kTimerId;
+    dmxnode::scenes::s_scene = scene;
+    dmxnode::scenes::s_port_mask = port_mask;
+    dmxnode::scenes::s_callback = callback;
+    dmxnode::scenes::s_state = dmxnode::scenes::State::kErasing;
+    return true;
+}
+
+bool DmxNode::IsSceneStoreBusy() const {
+    return dmxnode::scenes::s_state != dmxnode::scenes::State::kIdle;
 }
 
 void DmxNode::ScenePlayback() {
-    dmxnode::scenes::ReadStart();
+    // While a scene is being stored, the backup is what is being written to the flash
+    const auto kIsStoring = IsSceneStoreBusy();
+
+    if (!kIsStoring) {
+        dmxnode::scenes::ReadStart();
+    }
 
     auto *dmxnode_output_type = DmxNodeNodeType::Get()->GetOutput();
 
@@ -54,7 +160,10 @@ void DmxNode::ScenePlayback() {
         auto& port = port_[port_index];
 
         if (port.port_direction == dmxnode::Direction::kOutput) {
-            dmxnode::scenes::Read(port_index, const_cast<uint8_t*>(dmxnode::Data::Backup(port_index)));
+            if (!kIsStoring) {
+                dmxnode::scenes::Read(dmxnode::scenes::kFailSafe, port_index, const_cast<uint8_t*>(dmxnode::Data::Backup(port_index)));
+            }
+
             dmxnode::DataOutput(dmxnode_output_type, port_index);
 
             if (!port.is_transmitting) {
@@ -66,5 +175,7 @@ void DmxNode::ScenePlayback() {
         }
     }
 
-    dmxnode::scenes::ReadEnd();
+    if (!kIsStoring) {
+        dmxnode::scenes::ReadEnd();
+    }
 }
@@ -0,0 +1,243 @@
+/**
+ * @file dmxnode_scenes_fade.cpp
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "dmxnode.h"
+
+#if CONFIG_DMXNODE_SCENES > 0
+#include <cstdint>
+#include <cassert>
+
+#include "dmxnodedata.h"
+#include "dmxnode_nodetype.h"
+#include "softwaretimers.h"
+#include "dmxnode_debug.h"
+
+namespace dmxnode::scenes {
+static uint8_t s_target[dmxnode::kMaxPorts][dmxnode::kUniverseSize];
+static uint32_t s_fade_frames = kFadeMillis / kFrameMillis;
+static uint32_t s_frames_left;
+static uint32_t s_hold_frames_left;
+static uint32_t s_fade_scene;
+static uint8_t s_level;
+static bool s_is_sequence;
+static bool s_is_active;
+static TimerHandle_t s_fade_timer_id = kTimerIdNone;
+
+/*
+ * Moves value 1/frames_left of the remaining distance towards target, rounded half away from zero.
+ * With frames_left == 1 the target is reached, so there is no accumulated rounding error.
+ */
+static uint8_t Step(uint8_t value, uint8_t target, uint32_t frames_left) {
+    const auto kDelta = static_cast<int32_t>(target) - static_cast<int32_t>(value);
+    const auto kFrames = static_cast<int32_t>(frames_left);
+    const auto kStep = (kDelta >= 0) ? ((2 * kDelta + kFrames) / (2 * kFrames)) : -((-2 * kDelta + kFrames) / (2 * kFrames));
+
+    return static_cast<uint8_t>(static_cast<int32_t>(value) + kStep);
+}
+
+static bool IsSceneProgrammed(uint32_t scene) {
+    ReadStart();
+    const auto kIsProgrammed = IsProgrammed(scene);
+    ReadEnd();
+
+    return kIsProgrammed;
+}
+
+/*
+ * @return the first programmed scene after scene (wrapping around), kFailSafe when there is none
+ */
+static uint32_t NextProgrammed(uint32_t scene) {
+    ReadStart();
+
+    for (uint32_t i = 0; i < kScenes; i++) {
+        scene = (scene >= kScenes) ? 1 : scene + 1;
+
+        if (IsProgrammed(scene)) {
+            ReadEnd();
+            return scene;
+        }
+    }
+
+    ReadEnd();
+    return kFailSafe;
+}
+} // namespace dmxnode::scenes
+
+void DmxNode::SceneFadeTimer([[maybe_unused]] TimerHandle_t timer_handle) {
+    DmxNode::Instance().SceneFadeRun();
+}
+
+void DmxNode::SceneFadeStart(uint32_t scene, uint8_t level) {
+    using namespace dmxnode::scenes;
+    assert((scene != kFailSafe) && (scene <= kScenes));
+
+    DMXNODE_DEBUG_PRINTF("scene=%u, level=%u", static_cast<unsigned>(scene), static_cast<unsigned>(level));
+
+    ReadStart();
+
+    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+        if (port_[port_index].port_direction != dmxnode::Direction::kOutput) {
+            continue;
+        }
+
+        auto* target = s_target[port_index];
+
+        Read(scene, port_index, target);
+
+        if (level != dmxnode::kDmxMaxValue) {
+            for (uint32_t i = 0; i < dmxnode::kUniverseSize; i++) {
+                target[i] = static_cast<uint8_t>((target[i] * level + 127U) / 255U);
+            }
+        }
+    }
+
+    ReadEnd();
+
+    s_fade_scene = scene;
+    s_level = level;
+    s_frames_left = (s_fade_frames == 0) ? 1 : s_fade_frames;
+    s_is_active = true;
+
+    if (s_fade_timer_id == kTimerIdNone) {
+        s_fade_timer_id = SoftwareTimerAdd(kFrameMillis, SceneFadeTimer);
+        assert(s_fade_timer_id != kTimerIdNone);
+    }
+}
+
+/*
+ * Called every kFrameMillis. The output buffer is moved towards the target,
+ * only the remaining distance and the number of frames left are needed.
+ */
+void DmxNode::SceneFadeRun() {
+    using namespace dmxnode::scenes;
+
+    if (s_frames_left == 0) {
+        if (!s_is_sequence) {
+            // Fade done, the output holds the scene
+            SoftwareTimerDelete(s_fade_timer_id);
+            return;
+        }
+
+        if (s_hold_frames_left != 0) {
+            s_hold_frames_left--;
+            return;
+        }
+
+        // The flash is not read while a scene is being stored, the current scene is held longer
+        if (IsSceneStoreBusy()) {
+            return;
+        }
+
+        const auto kScene = NextProgrammed(s_fade_scene);
+
+        if (kScene == kFailSafe) {
+            SoftwareTimerDelete(s_fade_timer_id);
+            return;
+        }
+
+        SceneFadeStart(kScene, s_level);
+        return;
+    }
+
+    auto* dmxnode_output_type = DmxNodeNodeType::Get()->GetOutput();
+
+    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+        auto& port = port_[port_index];
+
+        if (port.port_direction != dmxnode::Direction::kOutput) {
+            continue;
+        }
+
+        auto* data = const_cast<uint8_t*>(dmxnode::Data::Backup(port_index));
+        const auto* target = s_target[port_index];
+
+        for (uint32_t i = 0; i < dmxnode::kUniverseSize; i++) {
+            data[i] = Step(data[i], target[i], s_frames_left);
+        }
+
+        dmxnode_output_type->SetData<true>(port_index, data, dmxnode::kUniverseSize);
+
+        if (!port.is_transmitting) {
+            dmxnode_output_type->Start(port_index);
+            port.is_transmitting = true;
+        }
+    }
+
+    s_frames_left--;
+
+    if ((s_frames_left == 0) && s_is_sequence) {
+        s_hold_frames_left = kHoldMillis / kFrameMillis;
+    }
+}
+
+bool DmxNode::SceneFade(uint32_t scene, uint8_t level) {
+    if ((scene == dmxnode::scenes::kFailSafe) || (scene > dmxnode::scenes::kScenes) || IsSceneStoreBusy()) {
+        return false;
+    }
+
+    // An erased scene would fade all output channels to 0xFF
+    if (!dmxnode::scenes::IsSceneProgrammed(scene)) {
+        return false;
+    }
+
+    dmxnode::scenes::s_is_sequence = false;
+    SceneFadeStart(scene, level);
+    return true;
+}
+
+bool DmxNode::SceneSequence(uint8_t level) {
+    if (IsSceneStoreBusy()) {
+        return false;
+    }
+
+    // The scenes which are not programmed are skipped
+    const auto kScene = dmxnode::scenes::NextProgrammed(dmxnode::scenes::kScenes);
+
+    if (kScene == dmxnode::scenes::kFailSafe) {
+        return false;
+    }
+
+    dmxnode::scenes::s_is_sequence = true;
+    SceneFadeStart(kScene, level);
+    return true;
+}
+
+void DmxNode::SceneFadeStop() {
+    if (dmxnode::scenes::s_fade_timer_id != kTimerIdNone) {
+        SoftwareTimerDelete(dmxnode::scenes::s_fade_timer_id);
+    }
+
+    dmxnode::scenes::s_is_sequence = false;
+    dmxnode::scenes::s_is_active = false;
+}
+
+bool DmxNode::IsScenePlaybackActive() const {
+    return dmxnode::scenes::s_is_active;
+}
+
+void DmxNode::SetSceneFadeMillis(uint32_t fade_millis) {
+    dmxnode::scenes::s_fade_frames = fade_millis / dmxnode::scenes::kFrameMillis;
+}
+#endif // CONFIG_DMXNODE_SCENES > 0
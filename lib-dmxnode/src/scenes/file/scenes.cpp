@@ -41,7 +41,7 @@ static constexpr char kFileName[] = "failsafe.bin";
 
 static FILE* s_file;
 
-void WriteStart() {
+bool WriteStart([[maybe_unused]] uint32_t scene) {
     DEBUG_ENTRY();
 
     if ((s_file = fopen(kFileName, "r+")) == nullptr) {
@@ -51,10 +51,10 @@ void WriteStart() {
             perror("fopen w+");
 
             DEBUG_EXIT();
-            return;
+            return true;
         }
 
-        for (uint32_t i = 0; i < dmxnode::scenes::kBytesNeeded; i++) {
+        for (uint32_t i = 0; i < (dmxnode::scenes::kSlots * dmxnode::scenes::kBytesNeeded); i++) {
             if (fputc(0xFF, s_file) == EOF) {
                 perror("fputc(0xFF, file)"); // Same as erasing a flash memory device
 
@@ -64,7 +64,7 @@ void WriteStart() {
 
                 s_file = nullptr;
                 DEBUG_EXIT();
-                return;
+                return true;
             }
         }
 
@@ -74,26 +74,54 @@ void WriteStart() {
     }
 
     DEBUG_EXIT();
+    return true;
 }
 
-void Write(uint32_t port_index, const uint8_t* data) {
+bool Write(uint32_t scene, uint32_t port_index, const uint8_t* data) {
     DEBUG_ENTRY();
+    assert(scene < dmxnode::scenes::kSlots);
     assert(port_index < dmxnode::kMaxPorts);
     assert(data != nullptr);
 
-    if (fseek(s_file, static_cast<long int>(port_index * dmxnode::kUniverseSize), SEEK_SET) != 0) {
+    if (fseek(s_file, static_cast<long int>((scene * dmxnode::scenes::kBytesNeeded) + (port_index * dmxnode::kUniverseSize)), SEEK_SET) != 0) {
         perror("fseek");
         DEBUG_EXIT();
-        return;
+        return true;
     }
 
     if (fwrite(data, 1, dmxnode::kUniverseSize, s_file) != dmxnode::kUniverseSize) {
         perror("fwrite");
         DEBUG_EXIT();
-        return;
+        return true;
     }
 
     DEBUG_EXIT();
+    return true;
+}
+
+bool WriteProgrammed(uint32_t scene) {
+    DEBUG_ENTRY();
+    assert(scene < dmxnode::scenes::kSlots);
+
+    if (s_file == nullptr) {
+        DEBUG_EXIT();
+        return true;
+    }
+
+    if (fseek(s_file, static_cast<long int>((scene * dmxnode::scenes::kBytesNeeded) + dmxnode::scenes::kProgrammedOffset), SEEK_SET) != 0) {
+        perror("fseek");
+        DEBUG_EXIT();
+        return true;
+    }
+
+    const auto kMarker = dmxnode::scenes::kProgrammedMarker;
+
+    if (fwrite(&kMarker, 1, sizeof(kMarker), s_file) != sizeof(kMarker)) {
+        perror("fwrite");
+    }
+
+    DEBUG_EXIT();
+    return true;
 }
 
 void WriteEnd() {
@@ -120,8 +148,9 @@ void ReadStart() {
     DEBUG_EXIT();
 }
 
-void Read(uint32_t port_index, uint8_t* data) {
+void Read(uint32_t scene, uint32_t port_index, uint8_t* data) {
     DEBUG_ENTRY();
+    assert(scene < dmxnode::scenes::kSlots);
     assert(port_index < dmxnode::kMaxPorts);
     assert(data != nullptr);
 
@@ -130,7 +159,7 @@ void Read(uint32_t port_index, uint8_t* data) {
         return;
     }
 
-    if (fseek(s_file, static_cast<long int>(port_index * dmxnode::kUniverseSize), SEEK_SET) != 0) {
+    if (fseek(s_file, static_cast<long int>((scene * dmxnode::scenes::kBytesNeeded) + (port_index * dmxnode::kUniverseSize)), SEEK_SET) != 0) {
         perror("fseek");
         DEBUG_EXIT();
         return;
@@ -145,6 +174,27 @@ void Read(uint32_t port_index, uint8_t* data) {
     DEBUG_EXIT();
 }
 
+bool IsProgrammed(uint32_t scene) {
+    assert(scene < dmxnode::scenes::kSlots);
+
+    if (s_file == nullptr) {
+        return false;
+    }
+
+    if (fseek(s_file, static_cast<long int>((scene * dmxnode::scenes::kBytesNeeded) + dmxnode::scenes::kProgrammedOffset), SEEK_SET) != 0) {
+        perror("fseek");
+        return false;
+    }
+
+    uint32_t marker;
+
+    if (fread(&marker, 1, sizeof(marker), s_file) != sizeof(marker)) {
+        return false;
+    }
+
+    return marker == dmxnode::scenes::kProgrammedMarker;
+}
+
 void ReadEnd() {
     DEBUG_ENTRY();
 
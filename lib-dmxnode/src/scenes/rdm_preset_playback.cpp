@@ -0,0 +1,69 @@
+/**
+ * @file rdm_preset_playback.cpp
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined(ENABLE_RDM_PRESET_PLAYBACK)
+#include <cstdint>
+
+#include "rdm_preset_playback.h"
+#include "dmxnode.h"
+
+namespace rdm::preset_playback {
+static uint16_t s_mode = kOff;
+static uint8_t s_level = dmxnode::kDmxMaxValue;
+
+void Get(uint16_t& mode, uint8_t& level) {
+    // A single fade ends in the scene, a sequence keeps running: both report the mode that was set
+    mode = DmxNode::Instance().IsScenePlaybackActive() ? s_mode : kOff;
+    level = s_level;
+}
+
+bool Set(uint16_t mode, uint8_t level) {
+    auto& dmxnode = DmxNode::Instance();
+
+    if (mode == kOff) {
+        dmxnode.SceneFadeStop();
+    } else if (mode == kAll) {
+        if (!dmxnode.SceneSequence(level)) {
+            return false;
+        }
+    } else if (!dmxnode.SceneFade(mode, level)) {
+        return false;
+    }
+
+    s_mode = mode;
+    s_level = level;
+    return true;
+}
+
+bool Capture(uint16_t scene) {
+    if ((scene == dmxnode::scenes::kFailSafe) || (scene > dmxnode::scenes::kScenes)) {
+        return false;
+    }
+
+    // The store is asynchronous, the scene is programmed when the job is done
+    return DmxNode::Instance().SceneStore(scene);
+}
+} // namespace rdm::preset_playback
+#endif // ENABLE_RDM_PRESET_PLAYBACK
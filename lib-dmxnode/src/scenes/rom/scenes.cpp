@@ -28,12 +28,22 @@
 
 #include "dmxnode_scenes.h"
 #include "flashcode.h"
+#if defined(CONFIG_STORE_ENABLE_LOG)
+#include "configstore_log.h"
+#endif
 #include "dmxnode_debug.h"
 
 namespace dmxnode::scenes {
+// The sectors at the end are used by the ConfigStore
+#if defined(CONFIG_STORE_ENABLE_LOG)
+static constexpr uint32_t kConfigStoreSectors = configstore::log::kSectors;
+#else
+static constexpr uint32_t kConfigStoreSectors = 1;
+#endif
 
 static bool s_is_detected;
 static uint32_t s_offset_base;
+static uint32_t s_scene_size;
 
 static bool IsDetected() {
     DMXNODE_DEBUG_ENTRY();
@@ -46,14 +56,14 @@ static bool IsDetected() {
         }
 
         const auto kEraseSize = FlashCode::Get()->GetSectorSize();
-        assert(kEraseSize <= dmxnode::scenes::kBytesNeeded);
-        const auto kPages = 1 + dmxnode::scenes::kBytesNeeded / kEraseSize;
+        const auto kPages = (dmxnode::scenes::kBytesNeeded + kEraseSize - 1) / kEraseSize;
 
         DMXNODE_DEBUG_PRINTF("Bytes needed=%u, kEraseSize=%u, kPages=%u", dmxnode::scenes::kBytesNeeded, kEraseSize, kPages);
 
-        assert(((kPages + 1) * kEraseSize) <= FlashCode::Get()->GetSize());
+        assert(((dmxnode::scenes::kSlots * kPages + kConfigStoreSectors) * kEraseSize) <= FlashCode::Get()->GetSize());
 
-        s_offset_base = FlashCode::Get()->GetSize() - ((kPages + 1) * kEraseSize);
+        s_scene_size = kPages * kEraseSize;
+        s_offset_base = FlashCode::Get()->GetSize() - (kConfigStoreSectors * kEraseSize);
 
         DMXNODE_DEBUG_PRINTF("nOffsetBase=%p", s_offset_base);
     }
@@ -62,54 +72,95 @@ static bool IsDetected() {
     return true;
 }
 
-void WriteStart() {
+/*
+ * Scene 0 is next to the ConfigStore sectors, the numbered scenes are below it.
+ */
+static uint32_t SceneOffset(uint32_t scene) {
+    assert(scene < dmxnode::scenes::kSlots);
+    return s_offset_base - ((scene + 1) * s_scene_size);
+}
+
+bool WriteStart(uint32_t scene) {
     DMXNODE_DEBUG_ENTRY();
     DMXNODE_DEBUG_PRINTF("isDetected=%d", s_is_detected);
 
     if (!IsDetected()) {
         DMXNODE_DEBUG_EXIT();
-        return;
+        return true;
+    }
+
+    // The ConfigStore shares the flash controller, wait until its operation is done
+    if (!FlashCode::Acquire(flashcode::Owner::kScenes)) {
+        DMXNODE_DEBUG_EXIT();
+        return false;
     }
 
     flashcode::Result result;
-    uint32_t timeout = 0;
 
-    while (!FlashCode::Get()->Erase(s_offset_base, FlashCode::Get()->GetSectorSize(), result)) {
-        timeout++;
+    if (!FlashCode::Get()->Erase(SceneOffset(scene), s_scene_size, result)) {
+        DMXNODE_DEBUG_EXIT();
+        return false;
     }
 
+    FlashCode::Release(flashcode::Owner::kScenes);
+
     s_is_detected = (result == flashcode::Result::kOk);
 
-    DMXNODE_DEBUG_PRINTF("result=%d, s_is_detected=%d, timeout=%u", result, s_is_detected, timeout);
+    DMXNODE_DEBUG_PRINTF("result=%d, s_is_detected=%d", result, s_is_detected);
     DMXNODE_DEBUG_EXIT();
+    return true;
 }
 
-void Write(uint32_t port_index, const uint8_t* data) {
-    DMXNODE_DEBUG_ENTRY();
+bool Write(uint32_t scene, uint32_t port_index, const uint8_t* data) {
     assert(port_index < dmxnode::kMaxPorts);
     assert(data != nullptr);
 
     if (!s_is_detected) {
-        DMXNODE_DEBUG_EXIT();
-        return;
+        return true;
     }
 
-    const auto kOffset = s_offset_base + (port_index * dmxnode::kUniverseSize);
+    const auto kOffset = SceneOffset(scene) + (port_index * dmxnode::kUniverseSize);
 
-    DMXNODE_DEBUG_PRINTF("s_offset_base=%p, kOffset=%p", s_offset_base, kOffset);
+    if (!FlashCode::Acquire(flashcode::Owner::kScenes)) {
+        return false;
+    }
 
     flashcode::Result result;
-    uint32_t timeout = 0;
 
-    while (!FlashCode::Get()->Write(kOffset, dmxnode::kUniverseSize, data, result)) {
-        timeout++;
+    if (!FlashCode::Get()->Write(kOffset, dmxnode::kUniverseSize, data, result)) {
+        return false;
     }
 
-    DMXNODE_DEBUG_PRINTF("nResult=%d, nTimeout=%u", result, timeout);
+    FlashCode::Release(flashcode::Owner::kScenes);
+
+    DMXNODE_DEBUG_PRINTF("s_offset_base=%p, kOffset=%p, result=%d", s_offset_base, kOffset, result);
 
     assert(result == flashcode::Result::kOk);
+    return true;
+}
 
-    DMXNODE_DEBUG_EXIT();
+bool WriteProgrammed(uint32_t scene) {
+    // FlashCode keeps the pointer until the write is done
+    alignas(4) static constexpr uint32_t kMarker = dmxnode::scenes::kProgrammedMarker;
+
+    if (!s_is_detected) {
+        return true;
+    }
+
+    if (!FlashCode::Acquire(flashcode::Owner::kScenes)) {
+        return false;
+    }
+
+    flashcode::Result result;
+
+    if (!FlashCode::Get()->Write(SceneOffset(scene) + dmxnode::scenes::kProgrammedOffset, sizeof(kMarker), reinterpret_cast<const uint8_t*>(&kMarker), result)) {
+        return false;
+    }
+
+    FlashCode::Release(flashcode::Owner::kScenes);
+
+    assert(result == flashcode::Result::kOk);
+    return true;
 }
 
 void WriteEnd() {
@@ -134,7 +185,7 @@ void ReadStart() {
     DMXNODE_DEBUG_EXIT();
 }
 
-void Read(uint32_t port_index, uint8_t* data) {
+void Read(uint32_t scene, uint32_t port_index, uint8_t* data) {
     DMXNODE_DEBUG_ENTRY();
     assert(port_index < dmxnode::kMaxPorts);
     assert(data != nullptr);
@@ -144,7 +195,7 @@ void Read(uint32_t port_index, uint8_t* data) {
         return;
     }
 
-    const auto kOffset = s_offset_base + (port_index * dmxnode::kUniverseSize);
+    const auto kOffset = SceneOffset(scene) + (port_index * dmxnode::kUniverseSize);
 
     DMXNODE_DEBUG_PRINTF("nOffsetBase=%p, nOffset=%p", s_offset_base, kOffset);
 
@@ -162,6 +213,20 @@ void Read(uint32_t port_index, uint8_t* data) {
     DMXNODE_DEBUG_EXIT();
 }
 
+bool IsProgrammed(uint32_t scene) {
+    if (!s_is_detected) {
+        return false;
+    }
+
+    uint32_t marker;
+    flashcode::Result result;
+
+    while (!FlashCode::Get()->Read(SceneOffset(scene) + dmxnode::scenes::kProgrammedOffset, sizeof(marker), reinterpret_cast<uint8_t*>(&marker), result)) {
+    }
+
+    return (result == flashcode::Result::kOk) && (marker == dmxnode::scenes::kProgrammedMarker);
+}
+
 void ReadEnd() {
     DMXNODE_DEBUG_ENTRY();
 
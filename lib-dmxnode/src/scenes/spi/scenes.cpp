@@ -27,12 +27,23 @@
 #include <cassert>
 
 #include "spi/spi_flash.h"
+#if defined(CONFIG_STORE_ENABLE_LOG)
+#include "configstore_log.h"
+#endif
 #include "dmxnode.h"
 #include "dmxnode_debug.h"
 
 namespace dmxnode::scenes {
+// The sectors at the end are used by the ConfigStore
+#if defined(CONFIG_STORE_ENABLE_LOG)
+static constexpr uint32_t kConfigStoreSectors = configstore::log::kSectors;
+#else
+static constexpr uint32_t kConfigStoreSectors = 1;
+#endif
+
 static bool s_has_flash;
 static uint32_t s_offset_base;
+static uint32_t s_scene_size;
 
 static bool CheckHaveFlash() {
     DMXNODE_DEBUG_ENTRY();
@@ -45,14 +56,14 @@ static bool CheckHaveFlash() {
         }
 
         const auto kEraseSize = spi_flash_get_sector_size();
-        assert(kEraseSize <= dmxnode::scenes::kBytesNeeded);
-        const auto kPages = 1 + (dmxnode::scenes::kBytesNeeded / kEraseSize);
+        const auto kPages = (dmxnode::scenes::kBytesNeeded + kEraseSize - 1) / kEraseSize;
 
         DMXNODE_DEBUG_PRINTF("Bytes needed=%u, nEraseSize=%u, nPages=%u", dmxnode::scenes::kBytesNeeded, kEraseSize, kPages);
 
-        assert(((kPages + 1) * kEraseSize) <= spi_flash_get_size());
+        assert(((dmxnode::scenes::kSlots * kPages + kConfigStoreSectors) * kEraseSize) <= spi_flash_get_size());
 
-        s_offset_base = spi_flash_get_size() - ((kPages + 1) * kEraseSize);
+        s_scene_size = kPages * kEraseSize;
+        s_offset_base = spi_flash_get_size() - (kConfigStoreSectors * kEraseSize);
 
         DMXNODE_DEBUG_PRINTF("nOffsetBase=%p", s_offset_base);
     }
@@ -61,38 +72,60 @@ static bool CheckHaveFlash() {
     return true;
 }
 
-void WriteStart() {
+/*
+ * Scene 0 is next to the ConfigStore sectors, the numbered scenes are below it.
+ */
+static uint32_t SceneOffset(uint32_t scene) {
+    assert(scene < dmxnode::scenes::kSlots);
+    return s_offset_base - ((scene + 1) * s_scene_size);
+}
+
+bool WriteStart(uint32_t scene) {
     DMXNODE_DEBUG_ENTRY();
     DMXNODE_DEBUG_PRINTF("s_hasFlash=%d", s_has_flash);
 
     if (!CheckHaveFlash()) {
         DMXNODE_DEBUG_EXIT();
-        return;
+        return true;
     }
 
-    s_has_flash = spi_flash_cmd_erase(s_offset_base, spi_flash_get_sector_size());
+    s_has_flash = spi_flash_cmd_erase(SceneOffset(scene), s_scene_size);
 
     DMXNODE_DEBUG_PRINTF("s_hasFlash=%d", s_has_flash);
     DMXNODE_DEBUG_EXIT();
+    return true;
 }
 
-void Write(uint32_t port_index, const uint8_t* data) {
+bool Write(uint32_t scene, uint32_t port_index, const uint8_t* data) {
     DMXNODE_DEBUG_ENTRY();
     assert(port_index < dmxnode::kMaxPorts);
     assert(data != nullptr);
 
     if (!s_has_flash) {
         DMXNODE_DEBUG_EXIT();
-        return;
+        return true;
     }
 
-    const auto kOffset = s_offset_base + (port_index * dmxnode::kUniverseSize);
+    const auto kOffset = SceneOffset(scene) + (port_index * dmxnode::kUniverseSize);
 
     DMXNODE_DEBUG_PRINTF("s_offset_base=%p, kOffset=%p", s_offset_base, kOffset);
 
     spi_flash_cmd_write_multi(kOffset, dmxnode::kUniverseSize, data);
 
     DMXNODE_DEBUG_EXIT();
+    return true;
+}
+
+bool WriteProgrammed(uint32_t scene) {
+    if (!s_has_flash) {
+        return true;
+    }
+
+    const auto kMarker = dmxnode::scenes::kProgrammedMarker;
+
+    spi_flash_cmd_write_multi(SceneOffset(scene) + dmxnode::scenes::kProgrammedOffset, sizeof(kMarker), reinterpret_cast<const uint8_t*>(&kMarker));
+
+    return true;
 }
 
 void WriteEnd() {
@@ -117,7 +150,7 @@ void ReadStart() {
     DMXNODE_DEBUG_EXIT();
 }
 
-void Read(uint32_t port_index, uint8_t* data) {
+void Read(uint32_t scene, uint32_t port_index, uint8_t* data) {
     DMXNODE_DEBUG_ENTRY();
     assert(port_index < dmxnode::kMaxPorts);
     assert(data != nullptr);
@@ -127,7 +160,7 @@ void Read(uint32_t port_index, uint8_t* data) {
         return;
     }
 
-    const auto kOffset = s_offset_base + (port_index * dmxnode::kUniverseSize);
+    const auto kOffset = SceneOffset(scene) + (port_index * dmxnode::kUniverseSize);
 
     DMXNODE_DEBUG_PRINTF("s_offset_base=%p, kOffset=%u", reinterpret_cast<void*>(s_offset_base), static_cast<unsigned>(kOffset));
 
@@ -136,6 +169,18 @@ void Read(uint32_t port_index, uint8_t* data) {
     DMXNODE_DEBUG_EXIT();
 }
 
+bool IsProgrammed(uint32_t scene) {
+    if (!s_has_flash) {
+        return false;
+    }
+
+    uint32_t marker;
+
+    spi_flash_cmd_read_fast(SceneOffset(scene) + dmxnode::scenes::kProgrammedOffset, sizeof(marker), reinterpret_cast<uint8_t*>(&marker));
+
+    return marker == dmxnode::scenes::kProgrammedMarker;
+}
+
 void ReadEnd() {
     DMXNODE_DEBUG_ENTRY();
 
@@ -50,6 +50,11 @@
 
 namespace flashcode {
 enum class Result { kOk, kError };
+/**
+ * The erase and write state machines are shared; an operation must be
+ * polled to completion by the owner that started it.
+ */
+enum class Owner { kNone, kConfigStore, kScenes };
 } // namespace flashcode
 
 class FlashCode {
@@ -67,10 +72,30 @@ class FlashCode {
     bool Erase(uint32_t offset, uint32_t length, flashcode::Result& result);
     bool Write(uint32_t offset, uint32_t length, const uint8_t* buffer, flashcode::Result& result);
 
+    /**
+     * @return false when an erase or write of another owner is in progress
+     */
+    static bool Acquire(flashcode::Owner owner) {
+        if ((s_owner != flashcode::Owner::kNone) && (s_owner != owner)) {
+            return false;
+        }
+        s_owner = owner;
+        return true;
+    }
+
+    static void Release(flashcode::Owner owner) {
+        if (s_owner == owner) {
+            s_owner = flashcode::Owner::kNone;
+        }
+    }
+
+    static bool IsFree() { return s_owner == flashcode::Owner::kNone; }
+
     static FlashCode* Get() { return s_this; }
 
    private:
     bool detected_{false};
+    inline static flashcode::Owner s_owner{flashcode::Owner::kNone};
     inline static FlashCode* s_this;
 };
 
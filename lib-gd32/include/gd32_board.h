@@ -115,6 +115,9 @@ void emac_debug_run();
 
 #include "softwaretimers.h" // IWYU pragma: keep
 #include "panelled.h"
+#if defined(CONFIG_I2C_ASYNC)
+#include "gd32_i2c.h"
+#endif // defined(CONFIG_I2C_ASYNC)
 
 namespace board {
 inline void Run() {
@@ -125,6 +128,9 @@ inline void Run() {
     SoftwareTimerRun();
 #endif // !defined(USE_FREE_RTOS)
     panelled::Run();
+#if defined(CONFIG_I2C_ASYNC)
+    Gd32I2cRun();
+#endif // defined(CONFIG_I2C_ASYNC)
 #if defined(CONFIG_DEBUG_STACK)
     debug::stack::Run();
 #endif // defined(CONFIG_DEBUG_STACK)
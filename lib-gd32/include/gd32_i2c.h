@@ -2,7 +2,7 @@
  * @file gd32_i2c.h
  *
  */
-/* Copyright (C) 2021-2025 by Arjan van Vught mailto:info@gd32-dmx.org
+/* Copyright (C) 2021-2026 by Arjan van Vught mailto:info@gd32-dmx.org
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -58,6 +58,47 @@ void Gd32I2cWriteReg(uint8_t address, uint8_t reg, uint16_t value);
 void Gd32I2cReadReg(uint8_t reg, uint8_t& value);
 void Gd32I2cReadReg(uint8_t address, uint8_t reg, uint8_t& value);
 
+#if defined(CONFIG_I2C_ASYNC)
+/*
+ * Interrupt driven transfers on I2C_PERIPH.
+ * The transactions are queued and executed in order, the caller owns the
+ * transaction and the buffers until it has completed.
+ * The callback is called from the interrupt handler, it must be short.
+ * The blocking API above is implemented with the same queue.
+ */
+namespace gd32::i2c
+{
+inline constexpr uint32_t kQueueSize = 8; ///< Must be power of 2
+inline constexpr uint8_t kPending = 0xFF;
+inline constexpr uint32_t kTimeoutMicros = 2000; ///< Without any bus progress
+} // namespace gd32::i2c
+
+struct Gd32I2cTransaction
+{
+    uint8_t address; ///< 7-bit
+    const uint8_t* write_buffer;
+    uint32_t write_length;
+    uint8_t* read_buffer; ///< Read after a repeated start
+    uint32_t read_length;
+    uint32_t baudrate; ///< 0 is the current baudrate
+    void (*callback)(Gd32I2cTransaction* transaction);
+    void* context;
+    volatile uint8_t rc; ///< gd32_i2c_rc_t, gd32::i2c::kPending while queued or running
+};
+
+void Gd32I2cAsyncBegin();
+bool Gd32I2cSubmit(Gd32I2cTransaction* transaction);
+bool Gd32I2cIsIdle();
+/**
+ * To be called from the superloop, a hanging bus does not generate an interrupt.
+ */
+void Gd32I2cRun();
+/**
+ * Blocking, for the synchronous API.
+ */
+uint8_t Gd32I2cTransfer(uint8_t address, const uint8_t* write_buffer, uint32_t write_length, uint8_t* read_buffer, uint32_t read_length);
+#endif
+
 #if defined(CONFIG_ENABLE_I2C1)
 void Gd32I2c1Begin();
 void Gd32I2c1SetBaudrate(uint32_t baudrate);
@@ -130,6 +130,12 @@ template <uint32_t PERIPH> static int32_t SendData(const uint8_t* data, uint32_t
 }
 
 template <uint32_t PERIPH> static int32_t WriteImplementation(const char* buffer, uint32_t length) {
+#if defined(CONFIG_I2C_ASYNC)
+    if constexpr (PERIPH == I2C_PERIPH) {
+        const auto kRc = Gd32I2cTransfer(static_cast<uint8_t>(GetAddress<PERIPH>() >> 1), reinterpret_cast<const uint8_t*>(buffer), length, nullptr, 0);
+        return -static_cast<int32_t>(kRc);
+    }
+#endif
     if (SendStart<PERIPH>() != GD32_I2C_OK) {
         SendStop<PERIPH>();
         return -1;
@@ -151,6 +157,11 @@ template <uint32_t PERIPH> static int32_t WriteImplementation(const char* buffer
 }
 
 template <uint32_t PERIPH> static uint8_t ReadImplementation(char* buffer, uint32_t length) {
+#if defined(CONFIG_I2C_ASYNC)
+    if constexpr (PERIPH == I2C_PERIPH) {
+        return Gd32I2cTransfer(static_cast<uint8_t>(GetAddress<PERIPH>() >> 1), nullptr, 0, reinterpret_cast<uint8_t*>(buffer), length);
+    }
+#endif
     auto timeout = kTimeout;
 
     while (i2c_flag_get(PERIPH, I2C_FLAG_I2CBSY)) {
@@ -354,9 +365,18 @@ void Gd32I2cBegin() {
     RcuConfigI2c();
     GpioConfigI2c();
     I2cConfig<I2C_PERIPH>();
+#if defined(CONFIG_I2C_ASYNC)
+    Gd32I2cAsyncBegin();
+#endif
 }
 
 void Gd32I2cSetBaudrate(uint32_t baudrate) {
+#if defined(CONFIG_I2C_ASYNC)
+    // Not while a queued transaction is running
+    while (!Gd32I2cIsIdle()) {
+        Gd32I2cRun();
+    }
+#endif
     i2c_clock_config(I2C_PERIPH, baudrate, I2C_DTCY_2);
 }
 
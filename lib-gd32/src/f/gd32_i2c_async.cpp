@@ -0,0 +1,426 @@
+/**
+ * @file gd32_i2c_async.cpp
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined(CONFIG_I2C_ASYNC)
+#pragma GCC push_options
+#pragma GCC optimize("O2")
+
+#include <cstdint>
+
+#include "gd32.h"
+#include "gd32_i2c.h"
+#include "timing.h"
+
+/*
+ * Master mode event handling as in the GD32F10x User Manual, 18.3.
+ * Receiving 1, 2 or more bytes each needs its own sequence for the ACK and the STOP.
+ */
+
+static_assert(I2C_PERIPH == I2C0, "The interrupt handlers are for I2C0");
+
+namespace
+{
+enum class Phase : uint8_t
+{
+    kIdle,
+    kWrite,
+    kRead
+};
+
+constexpr uint32_t kQueueMask = gd32::i2c::kQueueSize - 1;
+static_assert((gd32::i2c::kQueueSize & kQueueMask) == 0);
+
+constexpr int32_t kStopTimeout = 0xfff;
+
+Gd32I2cTransaction* s_queue[gd32::i2c::kQueueSize];
+volatile uint32_t s_head;
+volatile uint32_t s_current;
+volatile Phase s_phase = Phase::kIdle;
+uint32_t s_index;
+volatile uint32_t s_progress_micros;
+
+inline void InterruptsDisable()
+{
+    NVIC_DisableIRQ(I2C0_EV_IRQn);
+    NVIC_DisableIRQ(I2C0_ER_IRQn);
+}
+
+inline void InterruptsEnable()
+{
+    NVIC_EnableIRQ(I2C0_EV_IRQn);
+    NVIC_EnableIRQ(I2C0_ER_IRQn);
+}
+
+inline void ClearAddSend()
+{
+    // ADDSEND is cleared by reading STAT0 followed by reading STAT1
+    static_cast<void>(I2C_STAT0(I2C_PERIPH));
+    static_cast<void>(I2C_STAT1(I2C_PERIPH));
+}
+
+void StartNext()
+{
+    if (s_current == s_head)
+    {
+        I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) & ~(I2C_CTL1_EVIE | I2C_CTL1_BUFIE | I2C_CTL1_ERRIE);
+        s_phase = Phase::kIdle;
+        return;
+    }
+
+    const auto* transaction = s_queue[s_current & kQueueMask];
+
+    if (transaction->baudrate != 0)
+    {
+        i2c_clock_config(I2C_PERIPH, transaction->baudrate, I2C_DTCY_2);
+    }
+
+    s_index = 0;
+    s_phase = ((transaction->write_length != 0) || (transaction->read_length == 0)) ? Phase::kWrite : Phase::kRead;
+    s_progress_micros = timing::Micros();
+
+    I2C_CTL0(I2C_PERIPH) = (I2C_CTL0(I2C_PERIPH) & ~I2C_CTL0_POAP) | I2C_CTL0_ACKEN;
+    I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) | (I2C_CTL1_EVIE | I2C_CTL1_BUFIE | I2C_CTL1_ERRIE);
+    I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_START;
+}
+
+void Complete(uint8_t rc)
+{
+    auto timeout = kStopTimeout;
+
+    // The next START can only be given when the STOP has been sent
+    while ((I2C_CTL0(I2C_PERIPH) & I2C_CTL0_STOP) && (--timeout > 0))
+    {
+    }
+
+    auto* transaction = s_queue[s_current & kQueueMask];
+    s_current = s_current + 1;
+
+    transaction->rc = rc;
+
+    if (transaction->callback != nullptr)
+    {
+        transaction->callback(transaction);
+    }
+
+    StartNext();
+}
+
+void HandleWrite(uint32_t stat0, Gd32I2cTransaction* transaction)
+{
+    if ((stat0 & I2C_STAT0_TBE) && (s_index < transaction->write_length))
+    {
+        I2C_DATA(I2C_PERIPH) = transaction->write_buffer[s_index++];
+
+        if (s_index == transaction->write_length)
+        {
+            // Wait for BTC, the last byte has been sent
+            I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) & ~I2C_CTL1_BUFIE;
+        }
+        return;
+    }
+
+    if ((stat0 & I2C_STAT0_BTC) && (s_index == transaction->write_length))
+    {
+        if (transaction->read_length != 0)
+        {
+            s_index = 0;
+            s_phase = Phase::kRead;
+            I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) | I2C_CTL1_BUFIE;
+            I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_START; // Repeated start
+            return;
+        }
+
+        I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_STOP;
+        Complete(GD32_I2C_OK);
+    }
+}
+
+void HandleRead(uint32_t stat0, Gd32I2cTransaction* transaction)
+{
+    const auto kLength = transaction->read_length;
+    auto* buffer = transaction->read_buffer;
+
+    if (kLength == 1)
+    {
+        if (stat0 & I2C_STAT0_RBNE)
+        {
+            buffer[0] = static_cast<uint8_t>(I2C_DATA(I2C_PERIPH));
+            Complete(GD32_I2C_OK);
+        }
+        return;
+    }
+
+    const auto kRemaining = kLength - s_index;
+
+    if (stat0 & I2C_STAT0_BTC)
+    {
+        if (kRemaining == 3)
+        {
+            // Byte N-2 in DATA, N-1 in the shift register: N will be NACKed
+            I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) & ~I2C_CTL1_BUFIE;
+            I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) & ~I2C_CTL0_ACKEN;
+            buffer[s_index++] = static_cast<uint8_t>(I2C_DATA(I2C_PERIPH));
+            return;
+        }
+
+        if (kRemaining == 2)
+        {
+            I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_STOP;
+            buffer[s_index++] = static_cast<uint8_t>(I2C_DATA(I2C_PERIPH));
+            buffer[s_index++] = static_cast<uint8_t>(I2C_DATA(I2C_PERIPH));
+            Complete(GD32_I2C_OK);
+            return;
+        }
+    }
+
+    if ((stat0 & I2C_STAT0_RBNE) && (kRemaining > 3))
+    {
+        buffer[s_index++] = static_cast<uint8_t>(I2C_DATA(I2C_PERIPH));
+
+        if ((kLength - s_index) == 3)
+        {
+            // The last 3 bytes are handled on BTC
+            I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) & ~I2C_CTL1_BUFIE;
+        }
+    }
+}
+
+void HandleAddSend(Gd32I2cTransaction* transaction)
+{
+    if (s_phase == Phase::kWrite)
+    {
+        ClearAddSend();
+
+        if (transaction->write_length == 0)
+        {
+            // Probe, see Gd32I2cIsConnected
+            I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_STOP;
+            Complete(GD32_I2C_OK);
+        }
+        return;
+    }
+
+    if (transaction->read_length == 1)
+    {
+        I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) & ~I2C_CTL0_ACKEN;
+        ClearAddSend();
+        I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_STOP;
+        return;
+    }
+
+    if (transaction->read_length == 2)
+    {
+        // NACK the second byte, both bytes are read on BTC
+        I2C_CTL0(I2C_PERIPH) = (I2C_CTL0(I2C_PERIPH) & ~I2C_CTL0_ACKEN) | I2C_CTL0_POAP;
+        ClearAddSend();
+        I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) & ~I2C_CTL1_BUFIE;
+        return;
+    }
+
+    if (transaction->read_length == 3)
+    {
+        // The 3 bytes are handled on BTC, RBNE would enter the handler for nothing
+        I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) & ~I2C_CTL1_BUFIE;
+    }
+
+    ClearAddSend();
+}
+} // namespace
+
+extern "C"
+{
+    void I2C0_EV_IRQHandler()
+    {
+        const auto kStat0 = I2C_STAT0(I2C_PERIPH);
+
+        if (s_phase == Phase::kIdle)
+        {
+            I2C_CTL1(I2C_PERIPH) = I2C_CTL1(I2C_PERIPH) & ~(I2C_CTL1_EVIE | I2C_CTL1_BUFIE | I2C_CTL1_ERRIE);
+            return;
+        }
+
+        s_progress_micros = timing::Micros();
+
+        auto* transaction = s_queue[s_current & kQueueMask];
+
+        if (kStat0 & I2C_STAT0_SBSEND)
+        {
+            const auto kAddress = static_cast<uint32_t>(transaction->address << 1);
+            I2C_DATA(I2C_PERIPH) = (s_phase == Phase::kWrite) ? kAddress : (kAddress | 1U);
+            return;
+        }
+
+        if (kStat0 & I2C_STAT0_ADDSEND)
+        {
+            HandleAddSend(transaction);
+            return;
+        }
+
+        if (s_phase == Phase::kWrite)
+        {
+            HandleWrite(kStat0, transaction);
+        }
+        else
+        {
+            HandleRead(kStat0, transaction);
+        }
+    }
+
+    void I2C0_ER_IRQHandler()
+    {
+        const auto kStat0 = I2C_STAT0(I2C_PERIPH);
+
+        i2c_flag_clear(I2C_PERIPH, I2C_FLAG_AERR);
+        i2c_flag_clear(I2C_PERIPH, I2C_FLAG_LOSTARB);
+        i2c_flag_clear(I2C_PERIPH, I2C_FLAG_BERR);
+        i2c_flag_clear(I2C_PERIPH, I2C_FLAG_OUERR);
+
+        if (s_phase == Phase::kIdle)
+        {
+            return;
+        }
+
+        uint8_t rc = GD32_I2C_NOK;
+
+        if (kStat0 & I2C_STAT0_AERR)
+        {
+            rc = GD32_I2C_NACK;
+        }
+        else if (kStat0 & I2C_STAT0_LOSTARB)
+        {
+            rc = GD32_I2C_NOK_LA;
+        }
+
+        if (!(kStat0 & I2C_STAT0_LOSTARB))
+        {
+            I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_STOP;
+        }
+
+        Complete(rc);
+    }
+}
+
+void Gd32I2cAsyncBegin()
+{
+    s_head = 0;
+    s_current = 0;
+    s_phase = Phase::kIdle;
+
+    NVIC_SetPriority(I2C0_EV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL); // Lowest priority
+    NVIC_SetPriority(I2C0_ER_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+    InterruptsEnable();
+}
+
+bool Gd32I2cSubmit(Gd32I2cTransaction* transaction)
+{
+    InterruptsDisable();
+
+    if ((s_head - s_current) == gd32::i2c::kQueueSize)
+    {
+        InterruptsEnable();
+        return false;
+    }
+
+    transaction->rc = gd32::i2c::kPending;
+    s_queue[s_head & kQueueMask] = transaction;
+    s_head = s_head + 1;
+
+    if (s_phase == Phase::kIdle)
+    {
+        StartNext();
+    }
+
+    InterruptsEnable();
+    return true;
+}
+
+bool Gd32I2cIsIdle()
+{
+    return s_phase == Phase::kIdle;
+}
+
+void Gd32I2cRun()
+{
+    if (s_phase == Phase::kIdle)
+    {
+        return;
+    }
+
+    if ((timing::Micros() - s_progress_micros) < gd32::i2c::kTimeoutMicros)
+    {
+        return;
+    }
+
+    InterruptsDisable();
+
+    if (s_phase != Phase::kIdle)
+    {
+        // The bus is stuck, reset the peripheral
+        const auto kCkcfg = I2C_CKCFG(I2C_PERIPH);
+        const auto kRt = I2C_RT(I2C_PERIPH);
+        const auto kCtl1 = I2C_CTL1(I2C_PERIPH);
+
+        I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | I2C_CTL0_SRESET;
+        I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) & ~I2C_CTL0_SRESET;
+
+        I2C_CTL1(I2C_PERIPH) = kCtl1;
+        I2C_CKCFG(I2C_PERIPH) = kCkcfg;
+        I2C_RT(I2C_PERIPH) = kRt;
+        I2C_CTL0(I2C_PERIPH) = I2C_CTL0(I2C_PERIPH) | (I2C_CTL0_I2CEN | I2C_CTL0_ACKEN);
+
+        Complete(GD32_I2C_NOK_TOUT);
+    }
+
+    InterruptsEnable();
+}
+
+uint8_t Gd32I2cTransfer(uint8_t address, const uint8_t* write_buffer, uint32_t write_length, uint8_t* read_buffer, uint32_t read_length)
+{
+    Gd32I2cTransaction transaction;
+
+    transaction.address = address;
+    transaction.write_buffer = write_buffer;
+    transaction.write_length = write_length;
+    transaction.read_buffer = read_buffer;
+    transaction.read_length = read_length;
+    transaction.baudrate = 0;
+    transaction.callback = nullptr;
+    transaction.context = nullptr;
+
+    while (!Gd32I2cSubmit(&transaction))
+    {
+        Gd32I2cRun();
+    }
+
+    while (transaction.rc == gd32::i2c::kPending)
+    {
+        Gd32I2cRun();
+    }
+
+    return transaction.rc;
+}
+
+#pragma GCC pop_options
+#endif
@@ -26,9 +26,12 @@
 #define PIXELOUTPUT_H_
 
 #include <cstdint>
+#include <cassert>
 
+#include "pixeltype.h"
 #if defined(GD32)
 #include "gd32_spi.h"
+#include "softwaretimers.h"
 #elif defined(H3)
 #include "h3_spi.h"
 #endif
@@ -44,6 +47,17 @@ class PixelOutput
     void SetPixel(uint32_t index, uint8_t red, uint8_t green, uint8_t blue);
     void SetPixel(uint32_t index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white);
 
+    /**
+     * Maps count pixels from the DMX data, in the configured LED map, starting at pixel_index.
+     * Each pixel is repeated grouping_count times.
+     * The kernel for the LED type and map is selected by ApplyConfiguration.
+     */
+    void SetPixels(uint32_t pixel_index, const uint8_t* data, uint32_t count, uint32_t grouping_count)
+    {
+        assert(map_pixels_ != nullptr);
+        (this->*map_pixels_)(pixel_index, data, count, grouping_count);
+    }
+
     bool IsUpdating()
     {
 #if defined(GD32)
@@ -67,13 +81,73 @@ class PixelOutput
     static PixelOutput* Get() { return s_this; }
 
    private:
+    enum class Kernel
+    {
+        kRtz,
+        kRtzRgbw,
+        kWS2801,
+        kAPA102,
+        kP9813
+    };
+
+    using MapPixelsFunction = void (PixelOutput::*)(uint32_t, const uint8_t*, uint32_t, uint32_t);
+
     void SetupBuffers();
+    void StartUpdate();
+#if defined(GD32)
+    static void UpdateTimer(TimerHandle_t handle);
+#endif
+    void CopyFromFront(uint32_t begin, uint32_t end);
+    void SetupRTZTable();
+    void SelectMapPixels();
+    template <Kernel kKernel> static MapPixelsFunction SelectMap(pixel::LedMap map);
+    template <Kernel kKernel, pixel::LedMap kMap> void MapPixels(uint32_t pixel_index, const uint8_t* data, uint32_t count, uint32_t grouping_count);
     void SetColorWS28xx(uint32_t offset, uint8_t value);
+    void Fill(uint8_t* buffer, uint8_t value);
+
+    uint32_t PixelOffset(uint32_t pixel_index) const { return pixel_offset_ + pixel_index * pixel_size_; }
+
+    void SetWritten(uint32_t begin, uint32_t end)
+    {
+        if (begin < written_begin_)
+        {
+            written_begin_ = begin;
+        }
+
+        if (end > written_end_)
+        {
+            written_end_ = end;
+        }
+    }
 
    private:
+    /*
+     * The I2S sends 16-bit frames MSB first, so the bytes are stored swapped within each halfword.
+     * An RTZ frame starts with 4 zero bytes, which keeps the colour data word aligned.
+     */
+    static constexpr uint32_t kByteSwap = 1;
+    static constexpr uint32_t kRTZLeadingBytes = 4;
+
     uint32_t buf_size_;
-    uint8_t* buffer_{nullptr};
-    uint8_t* blackout_buffer_{nullptr};
+    uint32_t data_size_;
+    uint8_t* buffer_{nullptr};       ///< Back buffer, written by SetPixel
+    uint8_t* front_buffer_{nullptr}; ///< Sent by the DMA
+    MapPixelsFunction map_pixels_{nullptr};
+    // The pixels written since the last Update(), the others keep the value of the frame before
+    uint32_t written_begin_{UINT32_MAX};
+    uint32_t written_end_{0};
+    uint32_t count_{0};
+    uint32_t pixel_offset_{0}; ///< Byte offset of the first pixel
+    uint32_t pixel_size_{0};   ///< Bytes per pixel
+    // Cached from PixelConfiguration by ApplyConfiguration, SetPixel is called for every pixel
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+    const uint8_t* gamma_table_{nullptr};
+#endif
+    pixel::LedType type_{pixel::LedType::kUndefined};
+    bool is_rtz_protocol_{false};
+    uint8_t global_brightness_{0xFF};
+    uint8_t rtz_low_code_{0};
+    uint8_t rtz_high_code_{0};
 
     static inline PixelOutput* s_this;
 };
@@ -105,8 +105,8 @@ struct TypeInfo {
     [[nodiscard]] constexpr bool IsSpi() const { return protocol_type == ProtocolType::kSpi; }
 };
 
-static_assert(sizeof(TypeInfo) == 20, "TypeInfo must remain compact");
-static_assert(alignof(TypeInfo) == 4, "Unexpected TypeInfo alignment");
+static_assert((sizeof(const char*) != 4) || (sizeof(TypeInfo) == 20), "TypeInfo must remain compact");
+static_assert(alignof(TypeInfo) == alignof(const char*), "Unexpected TypeInfo alignment");
 
 constexpr TypeInfo MakeSpiTypeInfo(const char* name, LedCount led_count, uint32_t default_hz, uint32_t max_hz) {
     return TypeInfo{.name = name, .default_hz = default_hz, .max_hz = max_hz, .protocol_type = ProtocolType::kSpi, .led_count = led_count, .low_code = kNoCode, .high_code = kNoCode, .led_map = LedMap::kRGB};
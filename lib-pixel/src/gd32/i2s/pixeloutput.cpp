@@ -31,7 +31,15 @@
 #include "gd32_spi.h"
 #include "pixel_debug.h"
 
-static uint32_t s_tmp;
+namespace {
+TimerHandle_t s_update_timer_id = kTimerIdNone;
+
+void UpdateTimerDelete() {
+    if (s_update_timer_id != kTimerIdNone) {
+        SoftwareTimerDelete(s_update_timer_id);
+    }
+}
+} // namespace
 
 PixelOutput::PixelOutput() {
     PIXEL_DEBUG_ENTRY();
@@ -47,7 +55,8 @@ PixelOutput::PixelOutput() {
 }
 
 PixelOutput::~PixelOutput() {
-    blackout_buffer_ = nullptr;
+    UpdateTimerDelete();
+    front_buffer_ = nullptr;
     buffer_ = nullptr;
     s_this = nullptr;
 }
@@ -59,6 +68,9 @@ void PixelOutput::ApplyConfiguration() {
 
     pixel_configuration.Validate();
 
+    SetupRTZTable();
+    SelectMapPixels();
+
     if (!pixel_configuration.RefreshNeeded()) {
         PIXEL_DEBUG_EXIT();
         return;
@@ -70,7 +82,7 @@ void PixelOutput::ApplyConfiguration() {
 
     if (pixel_configuration.IsRTZProtocol()) {
         buf_size_ *= 8;
-        buf_size_ += 1;
+        buf_size_ += kRTZLeadingBytes;
     }
 
     const auto kType = pixel_configuration.GetType();
@@ -87,45 +99,144 @@ void PixelOutput::ApplyConfiguration() {
     PIXEL_DEBUG_EXIT();
 }
 
+/*
+ * The DMA buffer is split in a back buffer, written by SetPixel, and a front buffer, being sent.
+ * Update() swaps them, there is no copy of the pixel data.
+ */
 void PixelOutput::SetupBuffers() {
     PIXEL_DEBUG_ENTRY();
 
+    UpdateTimerDelete();
+
+    while (i2s::Gd32SpiDmaTxIsActive()) {
+    }
+
     uint32_t size;
 
     buffer_ = const_cast<uint8_t*>(i2s::Gd32SpiDmaTxPrepare(&size));
     assert(buffer_ != nullptr);
 
-    const auto kSizeHalf = size / 2;
+    const auto kSizeHalf = (size / 2) & static_cast<uint32_t>(~3);
+
+    front_buffer_ = buffer_ + kSizeHalf;
+
+    data_size_ = buf_size_;
+    buf_size_ = (buf_size_ + 3) & static_cast<uint32_t>(~3);
     assert(buf_size_ <= kSizeHalf);
 
-    blackout_buffer_ = buffer_ + (kSizeHalf & static_cast<uint32_t>(~3));
+    PIXEL_DEBUG_PRINTF("buf_size_=%u (%u), buffer_=%p, front_buffer_=%p", buf_size_, data_size_, buffer_, front_buffer_);
 
-    PIXEL_DEBUG_PRINTF("buf_size_=%u, buffer_=%p, blackout_buffer_=%p", buf_size_, buffer_, blackout_buffer_);
+    // The padding is never written by SetPixel
+    memset(buffer_, 0, buf_size_);
+    memset(front_buffer_, 0, buf_size_);
 
-    s_tmp = buf_size_;
-    buf_size_ = (buf_size_ + 3) & static_cast<uint32_t>(~3);
+    if (is_rtz_protocol_) {
+        Fill(buffer_, rtz_low_code_);
+        Fill(front_buffer_, rtz_low_code_);
+    }
+
+    written_begin_ = UINT32_MAX;
+    written_end_ = 0;
 
-    PIXEL_DEBUG_PRINTF("buf_size_=%u -> %d", buf_size_, buf_size_ - s_tmp);
     PIXEL_DEBUG_EXIT();
 }
 
-void PixelOutput::Update() {
-    assert(!IsUpdating());
+/*
+ * Fills the pixel data with value: the low code is all off, the high code is all on.
+ */
+void PixelOutput::Fill(uint8_t* buffer, uint8_t value) {
+    const auto kBegin = is_rtz_protocol_ ? kRTZLeadingBytes : 0;
+
+    for (auto i = kBegin; i < data_size_; i++) {
+        buffer[i ^ kByteSwap] = value;
+    }
+}
+
+/*
+ * Copies the bytes [begin, end) of the pixel data from the front buffer into the back buffer.
+ * The bytes are swapped within each halfword, so an end which is not halfword aligned is copied per byte.
+ */
+void PixelOutput::CopyFromFront(uint32_t begin, uint32_t end) {
+    if (begin >= end) {
+        return;
+    }
+
+    if ((begin & 1U) != 0) {
+        buffer_[begin ^ kByteSwap] = front_buffer_[begin ^ kByteSwap];
+        begin++;
+    }
+
+    if (((end & 1U) != 0) && (end > begin)) {
+        end--;
+        buffer_[end ^ kByteSwap] = front_buffer_[end ^ kByteSwap];
+    }
+
+    if (end > begin) {
+        memcpy(&buffer_[begin], &front_buffer_[begin], end - begin);
+    }
+}
+
+/*
+ * The back buffer has the frame before the one in the front buffer. The pixels which are
+ * not written for this frame must keep the value of the front buffer, so these are copied
+ * before the buffers are swapped. The front buffer is not being sent here.
+ */
+void PixelOutput::StartUpdate() {
+    if (written_begin_ >= written_end_) {
+        CopyFromFront(PixelOffset(0), PixelOffset(count_));
+    } else {
+        CopyFromFront(PixelOffset(0), PixelOffset(written_begin_));
+        CopyFromFront(PixelOffset(written_end_), PixelOffset(count_));
+    }
+
+    i2s::Gd32SpiDmaTxStart(buffer_, buf_size_);
+
+    auto* buffer = front_buffer_;
+    front_buffer_ = buffer_;
+    buffer_ = buffer;
+
+    written_begin_ = UINT32_MAX;
+    written_end_ = 0;
+}
 
-    for (auto i = s_tmp; i < buf_size_; i++) {
-        buffer_[i] = 0x00;
+void PixelOutput::UpdateTimer([[maybe_unused]] TimerHandle_t handle) {
+    if (i2s::Gd32SpiDmaTxIsActive()) {
+        return;
     }
 
-    const auto* src = reinterpret_cast<uint16_t*>(buffer_);
-    auto* dst = reinterpret_cast<uint16_t*>(blackout_buffer_);
+    SoftwareTimerDelete(s_update_timer_id);
+    s_this->StartUpdate();
+}
+
+/*
+ * When the previous frame is still being sent, the swap is done from a software timer as soon
+ * as the DMA has finished, the caller does not wait. Pixels written in the meantime go into
+ * the same back buffer, so the latest data is sent. Without a free timer, Update() waits.
+ */
+void PixelOutput::Update() {
+    if (i2s::Gd32SpiDmaTxIsActive()) {
+        if (s_update_timer_id == kTimerIdNone) {
+            s_update_timer_id = SoftwareTimerAdd(0, UpdateTimer);
+        }
+
+        if (s_update_timer_id != kTimerIdNone) {
+            return;
+        }
 
-    for (uint32_t i = 0; i < buf_size_ / 2; i++) {
-        dst[i] = __builtin_bswap16(src[i]);
+        // The timer pool is full (reported by SoftwareTimerAdd), the frame must not be lost
+        do {
+            __ISB();
+        } while (i2s::Gd32SpiDmaTxIsActive());
     }
 
-    i2s::Gd32SpiDmaTxStart(blackout_buffer_, buf_size_);
+    UpdateTimerDelete();
+    StartUpdate();
 }
 
+/*
+ * Blackout and FullOn are sent from the front buffer, so that the back buffer with
+ * the pixel data is kept for the next Update().
+ */
 void PixelOutput::Blackout() {
     PIXEL_DEBUG_ENTRY();
 
@@ -134,32 +245,31 @@ void PixelOutput::Blackout() {
         __ISB();
     } while (i2s::Gd32SpiDmaTxIsActive());
 
-    auto* buffer = buffer_;
-    buffer_ = blackout_buffer_;
-
-    auto& pixel_configuration = PixelConfiguration::Get();
+    // A deferred Update() would end it
+    UpdateTimerDelete();
 
-    const auto kType = pixel_configuration.GetType();
-    const auto kCount = pixel_configuration.GetCount();
+    auto* buffer = buffer_;
+    const auto kWrittenBegin = written_begin_;
+    const auto kWrittenEnd = written_end_;
+    buffer_ = front_buffer_;
 
-    if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) {
+    if ((type_ == pixel::LedType::kAPA102) || (type_ == pixel::LedType::kSK9822) || (type_ == pixel::LedType::kP9813)) {
         memset(buffer_, 0, 4);
 
-        for (uint32_t pixel_index = 0; pixel_index < kCount; pixel_index++) {
+        for (uint32_t pixel_index = 0; pixel_index < count_; pixel_index++) {
             SetPixel(pixel_index, 0, 0, 0);
         }
 
-        if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822)) {
-            memset(&buffer_[buf_size_ - 4], 0xFF, 4);
+        if ((type_ == pixel::LedType::kAPA102) || (type_ == pixel::LedType::kSK9822)) {
+            memset(&buffer_[data_size_ - 4], 0xFF, 4);
         } else {
-            memset(&buffer_[buf_size_ - 4], 0, 4);
+            memset(&buffer_[data_size_ - 4], 0, 4);
         }
     } else {
-        buffer_[0] = 0x00;
-        memset(&buffer_[1], kType == pixel::LedType::kWS2801 ? 0 : pixel_configuration.GetLowCode(), buf_size_);
+        Fill(buffer_, type_ == pixel::LedType::kWS2801 ? 0 : rtz_low_code_);
     }
 
-    Update();
+    i2s::Gd32SpiDmaTxStart(buffer_, buf_size_);
 
     // A blackout may not be interrupted.
     do {
@@ -167,6 +277,8 @@ void PixelOutput::Blackout() {
     } while (i2s::Gd32SpiDmaTxIsActive());
 
     buffer_ = buffer;
+    written_begin_ = kWrittenBegin;
+    written_end_ = kWrittenEnd;
 
     PIXEL_DEBUG_EXIT();
 }
@@ -179,32 +291,31 @@ void PixelOutput::FullOn() {
         __ISB();
     } while (i2s::Gd32SpiDmaTxIsActive());
 
-    auto* buffer = buffer_;
-    buffer_ = blackout_buffer_;
-
-    auto& pixel_configuration = PixelConfiguration::Get();
+    // A deferred Update() would end it
+    UpdateTimerDelete();
 
-    const auto kType = pixel_configuration.GetType();
-    const auto kCount = pixel_configuration.GetCount();
+    auto* buffer = buffer_;
+    const auto kWrittenBegin = written_begin_;
+    const auto kWrittenEnd = written_end_;
+    buffer_ = front_buffer_;
 
-    if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) {
+    if ((type_ == pixel::LedType::kAPA102) || (type_ == pixel::LedType::kSK9822) || (type_ == pixel::LedType::kP9813)) {
         memset(buffer_, 0, 4);
 
-        for (uint32_t pixel_index = 0; pixel_index < kCount; pixel_index++) {
+        for (uint32_t pixel_index = 0; pixel_index < count_; pixel_index++) {
             SetPixel(pixel_index, 0xFF, 0xFF, 0xFF);
         }
 
-        if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822)) {
-            memset(&buffer_[buf_size_ - 4], 0xFF, 4);
+        if ((type_ == pixel::LedType::kAPA102) || (type_ == pixel::LedType::kSK9822)) {
+            memset(&buffer_[data_size_ - 4], 0xFF, 4);
         } else {
-            memset(&buffer_[buf_size_ - 4], 0, 4);
+            memset(&buffer_[data_size_ - 4], 0, 4);
         }
     } else {
-        buffer_[0] = 0x00;
-        memset(&buffer_[1], kType == pixel::LedType::kWS2801 ? 0xFF : pixel_configuration.GetHighCode(), buf_size_);
+        Fill(buffer_, type_ == pixel::LedType::kWS2801 ? 0xFF : rtz_high_code_);
     }
 
-    Update();
+    i2s::Gd32SpiDmaTxStart(buffer_, buf_size_);
 
     // May not be interrupted.
     do {
@@ -212,6 +323,8 @@ void PixelOutput::FullOn() {
     } while (i2s::Gd32SpiDmaTxIsActive());
 
     buffer_ = buffer;
+    written_begin_ = kWrittenBegin;
+    written_end_ = kWrittenEnd;
 
     PIXEL_DEBUG_EXIT();
 }
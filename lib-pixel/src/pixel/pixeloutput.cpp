@@ -29,6 +29,7 @@
 #endif
 
 #include <cstdint>
+#include <cstring>
 #include <cassert>
 
 #include "pixeloutput.h"
@@ -38,40 +39,71 @@
 #include "gamma/gamma_tables.h"
 #endif
 
-void PixelOutput::SetColorWS28xx(uint32_t offset, uint8_t value) {
+/*
+ * Each colour bit is sent as one SPI byte, the low code or the high code, MSB first.
+ * The 8 SPI bytes for every colour value are built when the configuration is applied,
+ * already in the byte swapped DMA order.
+ */
+static uint8_t s_rtz_table[256][8] __attribute__((aligned(4)));
+
+void PixelOutput::SetupRTZTable() {
     auto& pixel_configuration = PixelConfiguration::Get();
-    assert(pixel_configuration.GetType() != pixel::LedType::kWS2801);
-    assert(buffer_ != nullptr);
-    assert(offset + 7 < buf_size_);
 
-    offset += 1;
+    count_ = pixel_configuration.GetCount();
+    type_ = pixel_configuration.GetType();
+    is_rtz_protocol_ = pixel_configuration.IsRTZProtocol();
+    global_brightness_ = pixel_configuration.GetGlobalBrightness();
+
+    if (is_rtz_protocol_) {
+        pixel_offset_ = kRTZLeadingBytes;
+        pixel_size_ = pixel_configuration.GetLedsPerPixel() * 8U;
+    } else if (type_ == pixel::LedType::kWS2801) {
+        pixel_offset_ = 0;
+        pixel_size_ = 3;
+    } else {
+        pixel_offset_ = 4; // Start frame
+        pixel_size_ = 4;
+    }
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+    gamma_table_ = pixel_configuration.GetGammaTable();
+#endif
 
     const auto kLowCode = pixel_configuration.GetLowCode();
     const auto kHighCode = pixel_configuration.GetHighCode();
 
-    for (uint8_t mask = 0x80; mask != 0; mask = static_cast<uint8_t>(mask >> 1)) {
-        if (value & mask) {
-            buffer_[offset] = kHighCode;
-        } else {
-            buffer_[offset] = kLowCode;
+    if (!is_rtz_protocol_ || ((kLowCode == rtz_low_code_) && (kHighCode == rtz_high_code_))) {
+        return;
+    }
+
+    rtz_low_code_ = kLowCode;
+    rtz_high_code_ = kHighCode;
+
+    for (uint32_t value = 0; value < 256; value++) {
+        for (uint32_t bit = 0; bit < 8; bit++) {
+            s_rtz_table[value][bit ^ kByteSwap] = (value & (0x80U >> bit)) ? kHighCode : kLowCode;
         }
-        offset++;
     }
 }
 
+void PixelOutput::SetColorWS28xx(uint32_t offset, uint8_t value) {
+    assert(type_ != pixel::LedType::kWS2801);
+    assert(buffer_ != nullptr);
+    assert(offset + kRTZLeadingBytes + 7 < buf_size_);
+
+    memcpy(__builtin_assume_aligned(&buffer_[offset + kRTZLeadingBytes], 4), s_rtz_table[value], 8);
+}
+
 void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue) {
-    auto& pixel_configuration = PixelConfiguration::Get();
-    assert(pixel_index < pixel_configuration.GetCount());
+    assert(pixel_index < count_);
+    SetWritten(pixel_index, pixel_index + 1);
 
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
-    const auto* gamma_table = pixel_configuration.GetGammaTable();
-
-    red = gamma_table[red];
-    green = gamma_table[green];
-    blue = gamma_table[blue];
+    red = gamma_table_[red];
+    green = gamma_table_[green];
+    blue = gamma_table_[blue];
 #endif
 
-    if (pixel_configuration.IsRTZProtocol()) {
+    if (is_rtz_protocol_) {
         const auto kOffset = pixel_index * 24U;
 
         SetColorWS28xx(kOffset, red);
@@ -82,15 +114,15 @@ void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uin
 
     assert(buffer_ != nullptr);
 
-    const auto kType = pixel_configuration.GetType();
+    const auto kType = type_;
 
     if (kType == pixel::LedType::kWS2801) {
         const auto kOffset = pixel_index * 3U;
         assert(kOffset + 2U < buf_size_);
 
-        buffer_[kOffset] = red;
-        buffer_[kOffset + 1] = green;
-        buffer_[kOffset + 2] = blue;
+        buffer_[kOffset ^ kByteSwap] = red;
+        buffer_[(kOffset + 1) ^ kByteSwap] = green;
+        buffer_[(kOffset + 2) ^ kByteSwap] = blue;
 
         return;
     }
@@ -99,10 +131,10 @@ void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uin
         const auto kOffset = 4U + (pixel_index * 4U);
         assert(kOffset + 3U < buf_size_);
 
-        buffer_[kOffset] = pixel_configuration.GetGlobalBrightness();
-        buffer_[kOffset + 1] = red;
-        buffer_[kOffset + 2] = green;
-        buffer_[kOffset + 3] = blue;
+        buffer_[kOffset ^ kByteSwap] = global_brightness_;
+        buffer_[(kOffset + 1) ^ kByteSwap] = red;
+        buffer_[(kOffset + 2) ^ kByteSwap] = green;
+        buffer_[(kOffset + 3) ^ kByteSwap] = blue;
 
         return;
     }
@@ -113,10 +145,10 @@ void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uin
 
         const auto kFlag = static_cast<uint8_t>(0xC0 | ((~blue & 0xC0) >> 2) | ((~green & 0xC0) >> 4) | ((~red & 0xC0) >> 6));
 
-        buffer_[kOffset] = kFlag;
-        buffer_[kOffset + 1] = blue;
-        buffer_[kOffset + 2] = green;
-        buffer_[kOffset + 3] = red;
+        buffer_[kOffset ^ kByteSwap] = kFlag;
+        buffer_[(kOffset + 1) ^ kByteSwap] = blue;
+        buffer_[(kOffset + 2) ^ kByteSwap] = green;
+        buffer_[(kOffset + 3) ^ kByteSwap] = red;
 
         return;
     }
@@ -126,16 +158,15 @@ void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uin
 }
 
 void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
-    assert(pixel_index < PixelConfiguration::Get().GetCount());
-    assert(PixelConfiguration::Get().GetType() == pixel::LedType::kSK6812W);
+    assert(pixel_index < count_);
+    assert(type_ == pixel::LedType::kSK6812W);
+    SetWritten(pixel_index, pixel_index + 1);
 
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
-    const auto* gamma_table = PixelConfiguration::Get().GetGammaTable();
-
-    red = gamma_table[red];
-    green = gamma_table[green];
-    blue = gamma_table[blue];
-    white = gamma_table[white];
+    red = gamma_table_[red];
+    green = gamma_table_[green];
+    blue = gamma_table_[blue];
+    white = gamma_table_[white];
 #endif
 
     const auto kOffset = pixel_index * 32U;
@@ -145,3 +176,148 @@ void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uin
     SetColorWS28xx(kOffset + 16, blue);
     SetColorWS28xx(kOffset + 24, white);
 }
+
+namespace {
+// The order in which the DMX slots of a pixel are sent, indexed by pixel::LedMap
+constexpr uint8_t kMapSlots[6][3] = {
+    {0, 1, 2}, // RGB
+    {0, 2, 1}, // RBG
+    {1, 0, 2}, // GRB
+    {2, 0, 1}, // GBR
+    {1, 2, 0}, // BRG
+    {2, 1, 0}  // BGR
+};
+} // namespace
+
+/*
+ * Same output as SetPixel for every pixel, but the LED type and map are compile time constants.
+ * A group is encoded once and then copied.
+ */
+template <PixelOutput::Kernel kKernel, pixel::LedMap kMap> void PixelOutput::MapPixels(uint32_t pixel_index, const uint8_t* data, uint32_t count, uint32_t grouping_count) {
+    constexpr auto kChannels = (kKernel == Kernel::kRtzRgbw) ? 4U : 3U;
+    constexpr auto kSlots = kMapSlots[static_cast<uint32_t>(kKernel == Kernel::kRtzRgbw ? pixel::LedMap::kRGB : kMap)];
+
+    assert(buffer_ != nullptr);
+    assert(pixel_index + (count * grouping_count) <= count_);
+
+    SetWritten(pixel_index, pixel_index + count * grouping_count);
+
+    for (uint32_t i = 0; i < count; i++, data += kChannels) {
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+        const auto kFirst = gamma_table_[data[kSlots[0]]];
+        const auto kSecond = gamma_table_[data[kSlots[1]]];
+        const auto kThird = gamma_table_[data[kSlots[2]]];
+#else
+        const auto kFirst = data[kSlots[0]];
+        const auto kSecond = data[kSlots[1]];
+        const auto kThird = data[kSlots[2]];
+#endif
+
+        if constexpr ((kKernel == Kernel::kRtz) || (kKernel == Kernel::kRtzRgbw)) {
+            constexpr auto kPixelSize = kChannels * 8U;
+            auto* dst = &buffer_[kRTZLeadingBytes + pixel_index * kPixelSize];
+
+            if constexpr (kKernel == Kernel::kRtz) {
+                memcpy(__builtin_assume_aligned(&dst[0], 4), s_rtz_table[kFirst], 8);
+                memcpy(__builtin_assume_aligned(&dst[8], 4), s_rtz_table[kSecond], 8);
+            } else {
+                // SK6812W is GRBW
+                memcpy(__builtin_assume_aligned(&dst[0], 4), s_rtz_table[kSecond], 8);
+                memcpy(__builtin_assume_aligned(&dst[8], 4), s_rtz_table[kFirst], 8);
+            }
+
+            memcpy(__builtin_assume_aligned(&dst[16], 4), s_rtz_table[kThird], 8);
+
+            if constexpr (kKernel == Kernel::kRtzRgbw) {
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+                memcpy(__builtin_assume_aligned(&dst[24], 4), s_rtz_table[gamma_table_[data[3]]], 8);
+#else
+                memcpy(__builtin_assume_aligned(&dst[24], 4), s_rtz_table[data[3]], 8);
+#endif
+            }
+
+            for (uint32_t k = 1; k < grouping_count; k++) {
+                memcpy(__builtin_assume_aligned(&dst[k * kPixelSize], 4), dst, kPixelSize);
+            }
+        } else if constexpr (kKernel == Kernel::kWS2801) {
+            // 3 bytes per pixel, the byte swap differs for odd and even pixels
+            for (uint32_t k = 0; k < grouping_count; k++) {
+                const auto kOffset = (pixel_index + k) * 3U;
+                buffer_[kOffset ^ kByteSwap] = kFirst;
+                buffer_[(kOffset + 1) ^ kByteSwap] = kSecond;
+                buffer_[(kOffset + 2) ^ kByteSwap] = kThird;
+            }
+        } else {
+            uint8_t led[4] __attribute__((aligned(4)));
+
+            if constexpr (kKernel == Kernel::kAPA102) {
+                led[0 ^ kByteSwap] = global_brightness_;
+                led[1 ^ kByteSwap] = kFirst;
+                led[2 ^ kByteSwap] = kSecond;
+                led[3 ^ kByteSwap] = kThird;
+            } else {
+                led[0 ^ kByteSwap] = static_cast<uint8_t>(0xC0 | ((~kThird & 0xC0) >> 2) | ((~kSecond & 0xC0) >> 4) | ((~kFirst & 0xC0) >> 6));
+                led[1 ^ kByteSwap] = kThird;
+                led[2 ^ kByteSwap] = kSecond;
+                led[3 ^ kByteSwap] = kFirst;
+            }
+
+            auto* dst = &buffer_[4U + pixel_index * 4U];
+
+            for (uint32_t k = 0; k < grouping_count; k++) {
+                memcpy(__builtin_assume_aligned(&dst[k * 4U], 4), led, 4);
+            }
+        }
+
+        pixel_index += grouping_count;
+    }
+}
+
+template <PixelOutput::Kernel kKernel> PixelOutput::MapPixelsFunction PixelOutput::SelectMap(pixel::LedMap map) {
+    switch (map) {
+        case pixel::LedMap::kRBG:
+            return &PixelOutput::MapPixels<kKernel, pixel::LedMap::kRBG>;
+        case pixel::LedMap::kGRB:
+            return &PixelOutput::MapPixels<kKernel, pixel::LedMap::kGRB>;
+        case pixel::LedMap::kGBR:
+            return &PixelOutput::MapPixels<kKernel, pixel::LedMap::kGBR>;
+        case pixel::LedMap::kBRG:
+            return &PixelOutput::MapPixels<kKernel, pixel::LedMap::kBRG>;
+        case pixel::LedMap::kBGR:
+            return &PixelOutput::MapPixels<kKernel, pixel::LedMap::kBGR>;
+        default:
+            return &PixelOutput::MapPixels<kKernel, pixel::LedMap::kRGB>;
+    }
+}
+
+void PixelOutput::SelectMapPixels() {
+    auto& pixel_configuration = PixelConfiguration::Get();
+    const auto kMap = pixel_configuration.GetMap();
+
+    if (is_rtz_protocol_) {
+        if (pixel_configuration.GetLedsPerPixel() == 4) {
+            map_pixels_ = &PixelOutput::MapPixels<Kernel::kRtzRgbw, pixel::LedMap::kRGBW>;
+            return;
+        }
+
+        map_pixels_ = SelectMap<Kernel::kRtz>(kMap);
+        return;
+    }
+
+    switch (type_) {
+        case pixel::LedType::kWS2801:
+            map_pixels_ = SelectMap<Kernel::kWS2801>(kMap);
+            break;
+        case pixel::LedType::kAPA102:
+        case pixel::LedType::kSK9822:
+            map_pixels_ = SelectMap<Kernel::kAPA102>(kMap);
+            break;
+        case pixel::LedType::kP9813:
+            map_pixels_ = SelectMap<Kernel::kP9813>(kMap);
+            break;
+        default:
+            assert(0);
+            __builtin_unreachable();
+            break;
+    }
+}
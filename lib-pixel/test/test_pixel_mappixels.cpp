@@ -0,0 +1,161 @@
+/**
+ * @file test_pixel_mappixels.cpp
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Host test: the MapPixels kernels selected for SetPixels must give the same
+ * buffer as SetPixel for every pixel, for each LED type, map and grouping.
+ * The platform part of PixelOutput is replaced by two plain buffers.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "pixeloutput.h"
+#include "pixelconfiguration.h"
+#include "pixeltype.h"
+
+namespace {
+uint32_t s_failed;
+
+#define CHECK(condition)                                                         \
+    do {                                                                         \
+        if (!(condition)) {                                                      \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            s_failed++;                                                          \
+        }                                                                        \
+    } while (false)
+
+constexpr uint32_t kBufferSize = 4096;
+uint8_t s_buffers[2][kBufferSize] __attribute__((aligned(4)));
+
+// The order in which the DMX slots of a pixel are passed to SetPixel, indexed by pixel::LedMap
+constexpr uint32_t kSlots[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {2, 0, 1}, {1, 2, 0}, {2, 1, 0}};
+} // namespace
+
+// Host platform part
+PixelOutput::PixelOutput() {
+    s_this = this;
+}
+
+PixelOutput::~PixelOutput() {
+    s_this = nullptr;
+}
+
+void PixelOutput::ApplyConfiguration() {
+    auto& pixel_configuration = PixelConfiguration::Get();
+
+    pixel_configuration.Validate();
+
+    SetupRTZTable();
+    SelectMapPixels();
+    SetupBuffers();
+}
+
+void PixelOutput::SetupBuffers() {
+    memset(s_buffers, 0, sizeof(s_buffers));
+
+    buffer_ = s_buffers[0];
+    front_buffer_ = s_buffers[1];
+    buf_size_ = kBufferSize;
+}
+
+void PixelOutput::Update() {
+    auto* buffer = front_buffer_;
+    front_buffer_ = buffer_;
+    buffer_ = buffer;
+}
+
+namespace {
+void TestMapPixels(PixelConfiguration& pixel_configuration, pixel::LedType type, pixel::LedMap map, uint32_t count, uint32_t grouping_count) {
+    pixel_configuration.SetType(type);
+    pixel_configuration.SetCount(count);
+    pixel_configuration.SetMap(map);
+
+    PixelOutput pixel_output;
+    pixel_output.ApplyConfiguration();
+
+    const auto kLedsPerPixel = pixel_configuration.GetLedsPerPixel();
+    const auto kMap = static_cast<uint32_t>(pixel_configuration.GetMap());
+    const auto kGroups = count / grouping_count;
+
+    uint8_t data[512];
+
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<uint8_t>(i * 37U + 11U);
+    }
+
+    // Reference: SetPixel in the first buffer
+    const auto* slots = data;
+
+    for (uint32_t group = 0; group < kGroups; group++, slots += kLedsPerPixel) {
+        for (uint32_t k = 0; k < grouping_count; k++) {
+            const auto kPixelIndex = group * grouping_count + k;
+
+            if (kLedsPerPixel == 4) {
+                pixel_output.SetPixel(kPixelIndex, slots[0], slots[1], slots[2], slots[3]);
+            } else {
+                pixel_output.SetPixel(kPixelIndex, slots[kSlots[kMap][0]], slots[kSlots[kMap][1]], slots[kSlots[kMap][2]]);
+            }
+        }
+    }
+
+    // The kernel in the second buffer
+    pixel_output.Update();
+    pixel_output.SetPixels(0, data, kGroups, grouping_count);
+
+    const auto kEqual = memcmp(s_buffers[0], s_buffers[1], kBufferSize) == 0;
+
+    if (!kEqual) {
+        printf("type=%s map=%s count=%u grouping_count=%u\n", pixel::GetTypeName(type), pixel::GetMapName(map), static_cast<unsigned>(count), static_cast<unsigned>(grouping_count));
+    }
+
+    CHECK(kEqual);
+}
+} // namespace
+
+int main() {
+    PixelConfiguration pixel_configuration;
+
+    constexpr pixel::LedType kTypes[] = {pixel::LedType::kWS2812B, pixel::LedType::kSK6812W, pixel::LedType::kWS2801, pixel::LedType::kAPA102, pixel::LedType::kSK9822, pixel::LedType::kP9813};
+    constexpr pixel::LedMap kMaps[] = {pixel::LedMap::kRGB, pixel::LedMap::kRBG, pixel::LedMap::kGRB, pixel::LedMap::kGBR, pixel::LedMap::kBRG, pixel::LedMap::kBGR};
+
+    for (const auto kType : kTypes) {
+        for (const auto kMap : kMaps) {
+            for (uint32_t grouping_count = 1; grouping_count <= 4; grouping_count++) {
+                // An odd count for the WS2801, where the byte swap differs for odd and even pixels
+                TestMapPixels(pixel_configuration, kType, kMap, 30, grouping_count);
+                TestMapPixels(pixel_configuration, kType, kMap, 31, grouping_count);
+            }
+        }
+    }
+
+    if (s_failed != 0) {
+        printf("%u check(s) failed\n", static_cast<unsigned>(s_failed));
+        return 1;
+    }
+
+    puts("All tests passed");
+    return 0;
+}
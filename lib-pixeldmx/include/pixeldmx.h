@@ -132,11 +132,7 @@ class PixelDmx final : public PixelDmxConfiguration {
         assert(data != nullptr);
         assert(length <= dmxnode::kUniverseSize);
 
-        if (output_type_.IsUpdating()) {
-            puts("output_type_.IsUpdating()");
-            return;
-        }
-
+        // The pixels are written into the back buffer, also while the previous frame is being sent
         auto& port_info = PixelDmxConfiguration::GetPortInfo();
         uint32_t d = 0;
 
@@ -161,76 +157,9 @@ class PixelDmx final : public PixelDmxConfiguration {
 
         const auto kGroupingCount = PixelDmxConfiguration::GetGroupingCount();
 
-        if (kChannelsPerPixel == 3) {
-            switch (PixelDmxConfiguration::GetMap()) {
-                case pixel::LedMap::kRGB:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 0], data[d + 1], data[d + 2]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kRBG:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 0], data[d + 2], data[d + 1]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kGRB:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 1], data[d + 0], data[d + 2]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kGBR:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 2], data[d + 0], data[d + 1]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kBRG:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 1], data[d + 2], data[d + 0]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kBGR:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 2], data[d + 1], data[d + 0]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                default:
-                    assert(0);
-                    __builtin_unreachable();
-                    break;
-            }
-        } else {
-            assert(kChannelsPerPixel == 4);
-            for (auto j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                auto const kPixelIndexStart = (j * kGroupingCount);
-                for (uint32_t k = 0; k < kGroupingCount; k++) {
-                    output_type_.SetPixel(kPixelIndexStart + k, data[d], data[d + 1], data[d + 2], data[d + 3]);
-                }
-                d = d + 4;
-            }
+        if ((kEndIndex > kBeginIndex) && (d < length)) {
+            const auto kCount = std::min(kEndIndex - kBeginIndex, (length - d + kChannelsPerPixel - 1U) / kChannelsPerPixel);
+            output_type_.SetPixels(kBeginIndex * kGroupingCount, &data[d], kCount, kGroupingCount);
         }
 
 #if !defined(DMXNODE_PORTS)
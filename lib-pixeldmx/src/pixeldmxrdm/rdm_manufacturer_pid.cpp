@@ -64,7 +64,7 @@ constexpr char PixelCount::kDescription[];
 constexpr char PixelGroupingCount::kDescription[];
 constexpr char PixelMap::kDescription[];
 
-const rdmhandler::ParameterDescription RDMHandler::PARAMETER_DESCRIPTIONS[] = {
+constexpr rdmhandler::ParameterDescription RDMHandler::PARAMETER_DESCRIPTIONS[] = {
     {E120_MANUFACTURER_PIXEL_TYPE::kCode, rdmhandler::kDeviceDescriptionMaxLength, E120_DS_ASCII,
 #if defined(CONFIG_RDM_MANUFACTURER_PIDS_SET)
      E120_CC_GET_SET,
@@ -97,6 +97,7 @@ const rdmhandler::ParameterDescription RDMHandler::PARAMETER_DESCRIPTIONS[] = {
      0, E120_UNITS_NONE, E120_PREFIX_NONE, 0, 0, 0, rdmhandler::Description<PixelMap, sizeof(PixelMap::kDescription)>::kValue, RDMHandler::PdlParameterDescription(sizeof(PixelMap::kDescription))}};
 
 uint32_t RDMHandler::GetParameterDescriptionCount() const {
+    static_assert(rdmhandler::IsSortedByPid(PARAMETER_DESCRIPTIONS), "PARAMETER_DESCRIPTIONS must be sorted by PID");
     return sizeof(RDMHandler::PARAMETER_DESCRIPTIONS) / sizeof(RDMHandler::PARAMETER_DESCRIPTIONS[0]);
 }
 
@@ -80,6 +80,7 @@ class Rdm {
     static void TransmitDiscoveryRespondMessage(uint32_t port_index, const uint8_t* rdm_data, uint32_t length) { Dmx::Get()->RdmTransmitDiscoveryRespondMessage(port_index, rdm_data, length); }
 
     static const uint8_t* Receive(uint32_t port_index) { return Dmx::Get()->RdmReceive(port_index); }
+    static const uint8_t* Receive(uint32_t port_index, uint32_t& length) { return Dmx::Get()->RdmReceive(port_index, length); }
     static const uint8_t* ReceiveTimeOut(uint32_t port_index, uint16_t time_out) { return Dmx::Get()->RdmReceiveTimeOut(port_index, time_out); }
 
    private:
@@ -209,6 +209,22 @@
 
 
 
+/********************************************************/
+/* Table B-2: Status Message ID Definitions             */
+/********************************************************/
+#define E120_STS_CAL_FAIL                                 0x0001
+#define E120_STS_SENS_NOT_FOUND                           0x0002
+#define E120_STS_SENS_ALWAYS_ON                           0x0003
+#define E120_STS_OVERTEMP                                 0x0021
+#define E120_STS_UNDERTEMP                                0x0022
+#define E120_STS_SENS_OUT_RANGE                           0x0023
+#define E120_STS_OVERVOLTAGE_PHASE                        0x0024
+#define E120_STS_UNDERVOLTAGE_PHASE                       0x0025
+#define E120_STS_OVERCURRENT                              0x0026
+#define E120_STS_UNDERCURRENT                             0x0027
+
+
+
 /********************************************************/
 /* Table A-5: Product Category Defines                  */
 /********************************************************/
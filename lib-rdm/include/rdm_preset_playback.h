@@ -34,6 +34,7 @@ inline constexpr uint16_t kAll = 0xFFFF;
 
 void Get(uint16_t& mode, uint8_t& level);
 bool Set(uint16_t mode, uint8_t level);
+bool Capture(uint16_t scene);
 } // namespace rdm::preset_playback
 
 #endif /* RDM_PRESET_PLAYBACK_H_ */
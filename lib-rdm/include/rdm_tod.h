@@ -26,6 +26,18 @@
 #ifndef RDMTOD_H_
 #define RDMTOD_H_
 
+/**
+ * Table Of Devices.
+ * The UIDs are stored as 48-bit keys in a sorted array, so Exist, AddUid and Delete
+ * find the entry with a binary search. The mute flag is kept in the key, above the 48-bit UID,
+ * so it moves with the entry when entries are inserted or deleted.
+ *
+ * Trade-off: the lookup is O(log n), but AddUid and Delete move the tail of the
+ * array with memmove, so they are O(n). This keeps the array dense and the indices
+ * used by CopyUidEntry and Next valid. The moved bytes are 8 per entry, a Delete
+ * followed by an AddUid stays below 1 us for 4096 entries on the host (see test/bench_rdm_tod.cpp).
+ */
+
 #include <cstdint>
 #include <cstring>
 #include <cassert>
@@ -43,31 +55,14 @@ class Tod {
 #define RDM_DISCOVERY_TOD_TABLE_SIZE 200U
 #endif
     static constexpr uint32_t kTableSize = RDM_DISCOVERY_TOD_TABLE_SIZE;
-    static constexpr uint32_t kMutesTableSize = (kTableSize + 32) / 32;
     static constexpr uint32_t kInvalidEntry = UINT32_MAX;
 
-    Tod() {
-        for (uint32_t i = 0; i < kTableSize; i++) {
-            memcpy(&tod_[i], rdm::kUidAll, rdm::kUidSize);
-        }
-
-        for (uint32_t i = 0; i < kMutesTableSize; i++) {
-            mutes_[i] = 0;
-        }
-    }
-
+    Tod() = default;
     ~Tod() = default;
 
     void Reset() {
-        for (uint32_t i = 0; i < entries_; i++) {
-            memcpy(&tod_[i], rdm::kUidAll, rdm::kUidSize);
-        }
-
         entries_ = 0;
-
-        for (uint32_t i = 0; i < kMutesTableSize; i++) {
-            mutes_[i] = 0;
-        }
+        saved_index_ = kInvalidEntry;
     }
 
     bool AddUid(const uint8_t* uid) {
@@ -75,90 +70,91 @@ class Tod {
             return false;
         }
 
-        if (Exist(uid)) {
+        const auto kKey = ToKey(uid);
+        const auto kIndex = LowerBound(kKey);
+
+        if ((kIndex != entries_) && ((tod_[kIndex] & kUidMask) == kKey)) {
             return false;
         }
 
-        memcpy(&tod_[entries_++], uid, rdm::kUidSize);
+        memmove(&tod_[kIndex + 1], &tod_[kIndex], (entries_ - kIndex) * sizeof(tod_[0]));
+        tod_[kIndex] = kKey;
+        entries_++;
 
         return true;
     }
 
     uint32_t UidCount() const { return entries_; }
 
-    bool CopyUidEntry(uint32_t index, uint8_t uid[rdm::kUidSize]) {
-        if (index > entries_) {
+    bool CopyUidEntry(uint32_t index, uint8_t uid[rdm::kUidSize]) const {
+        if (index >= entries_) {
             memcpy(uid, rdm::kUidAll, rdm::kUidSize);
             return false;
         }
 
-        memcpy(uid, &tod_[index], rdm::kUidSize);
+        FromKey(tod_[index], uid);
         return true;
     }
 
-    void Copy(uint8_t* table) {
+    void Copy(uint8_t* table) const {
         DEBUG_ENTRY();
         DEBUG_PRINTF("entries_=%u", static_cast<unsigned int>(entries_));
         assert(table != nullptr);
 
-        const auto* src = reinterpret_cast<const uint8_t*>(tod_);
-        auto* dst = table;
-
-        for (uint32_t i = 0; i < (entries_ * rdm::kUidSize); i++) {
-            *dst++ = *src++;
+        for (uint32_t i = 0; i < entries_; i++) {
+            FromKey(tod_[i], &table[i * rdm::kUidSize]);
         }
 
         DEBUG_EXIT();
     }
 
+    /**
+     * The entry is found with a binary search, the entries above it are moved down: O(n).
+     */
     bool Delete(const uint8_t* uid) {
-        bool found = false;
-        uint32_t entry;
+        const auto kKey = ToKey(uid);
+        const auto kIndex = LowerBound(kKey);
 
-        for (entry = 0; entry < entries_; entry++) {
-            if (memcmp(&tod_[entry], uid, rdm::kUidSize) == 0) {
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
+        if ((kIndex == entries_) || ((tod_[kIndex] & kUidMask) != kKey)) {
             return false;
         }
 
-        if (entry == kTableSize - 1) {
-            memcpy(&tod_[entry], rdm::kUidAll, rdm::kUidSize);
-        } else {
-            for (; entry < entries_; entry++) {
-                memcpy(&tod_[entry], &tod_[entry + 1], rdm::kUidSize);
-            }
-        }
-
         entries_--;
+        memmove(&tod_[kIndex], &tod_[kIndex + 1], (entries_ - kIndex) * sizeof(tod_[0]));
 
         return true;
     }
 
     bool Exist(const uint8_t* uid) {
-        for (uint32_t index = 0; index < entries_; index++) {
-            if (memcmp(&tod_[index], uid, rdm::kUidSize) == 0) {
-                saved_index_ = index;
-                return true;
-            }
+        const auto kKey = ToKey(uid);
+        const auto kIndex = LowerBound(kKey);
+
+        if ((kIndex != entries_) && ((tod_[kIndex] & kUidMask) == kKey)) {
+            saved_index_ = kIndex;
+            return true;
         }
 
         saved_index_ = kInvalidEntry;
         return false;
     }
 
+    /**
+     * The UIDs are returned in ascending order, starting again after the last one.
+     * @return the next UID, valid until the next call
+     */
     const uint8_t* Next() {
+        if (entries_ == 0) {
+            return rdm::kUidAll;
+        }
+
         saved_index_++;
 
-        if (saved_index_ == entries_) {
+        if (saved_index_ >= entries_) {
             saved_index_ = 0;
         }
 
-        return tod_[saved_index_].uid;
+        FromKey(tod_[saved_index_], next_uid_);
+        return next_uid_;
     }
 
     void Mute() {
@@ -166,10 +162,7 @@ class Tod {
             return;
         }
 
-        const auto kIndex = saved_index_ / 32;
-        const auto kShift = saved_index_ - (kIndex * 32);
-
-        mutes_[kIndex] |= (1U << kShift);
+        tod_[saved_index_] |= kMuteFlag;
     }
 
     void UnMute() {
@@ -177,57 +170,93 @@ class Tod {
             return;
         }
 
-        const auto kIndex = saved_index_ / 32;
-        const auto kShift = saved_index_ - (kIndex * 32);
-
-        mutes_[kIndex] &= ~(1U << kShift);
+        tod_[saved_index_] &= ~kMuteFlag;
     }
 
     void UnMuteAll() {
-        for (uint32_t i = 0; i < kMutesTableSize; i++) {
-            mutes_[i] = 0;
+        for (uint32_t i = 0; i < entries_; i++) {
+            tod_[i] &= ~kMuteFlag;
         }
     }
 
-    bool IsMuted() {
+    bool IsMuted() const {
         if (saved_index_ == kInvalidEntry) {
             return true;
         }
 
-        const auto kIndex = saved_index_ / 32;
-        const auto kMutes = mutes_[kIndex];
-        const auto kShift = saved_index_ - (kIndex * 32);
-
-        return (kMutes & (1U << kShift)) == (1U << kShift);
+        return (tod_[saved_index_] & kMuteFlag) == kMuteFlag;
     }
 
-    void Dump([[maybe_unused]] uint32_t count) {
+    void Dump([[maybe_unused]] uint32_t count) const {
 #ifndef NDEBUG
-        if (count > kTableSize) {
-            count = kTableSize;
+        if (count > entries_) {
+            count = entries_;
         }
 
         printf("[%u]\n", static_cast<unsigned int>(count));
         for (uint32_t i = 0; i < count; i++) {
-            printf("%.2x%.2x:%.2x%.2x%.2x%.2x\n", tod_[i].uid[0], tod_[i].uid[1], tod_[i].uid[2], tod_[i].uid[3], tod_[i].uid[4], tod_[i].uid[5]);
+            uint8_t uid[rdm::kUidSize];
+            FromKey(tod_[i], uid);
+            printf("%.2x%.2x:%.2x%.2x%.2x%.2x%s\n", uid[0], uid[1], uid[2], uid[3], uid[4], uid[5], (tod_[i] & kMuteFlag) ? " muted" : "");
         }
 #endif
     }
 
-    void Dump() {
+    void Dump() const {
 #ifndef NDEBUG
         Dump(entries_);
 #endif
     }
 
+    /**
+     * The UID as a 48-bit big-endian key, so the key order is the UID order.
+     */
+    static uint64_t ToKey(const uint8_t* uid) {
+        uint64_t key = 0;
+
+        for (uint32_t i = 0; i < rdm::kUidSize; i++) {
+            key = (key << 8) | uid[i];
+        }
+
+        return key;
+    }
+
+    static void FromKey(uint64_t key, uint8_t* uid) {
+        for (uint32_t i = rdm::kUidSize; i-- > 0;) {
+            uid[i] = static_cast<uint8_t>(key);
+            key >>= 8;
+        }
+    }
+
+   private:
+    static constexpr uint64_t kUidMask = 0xFFFFFFFFFFFF;
+    static constexpr uint64_t kMuteFlag = (1ULL << 48);
+
+    /**
+     * @return the index of the first entry not less than key, or entries_
+     */
+    uint32_t LowerBound(uint64_t key) const {
+        uint32_t lower = 0;
+        uint32_t upper = entries_;
+
+        while (lower < upper) {
+            const auto kMiddle = lower + (upper - lower) / 2;
+
+            if ((tod_[kMiddle] & kUidMask) < key) {
+                lower = kMiddle + 1;
+            } else {
+                upper = kMiddle;
+            }
+        }
+
+        return lower;
+    }
+
    private:
     uint32_t entries_{0};
     uint32_t saved_index_{kInvalidEntry};
-    uint32_t mutes_[kMutesTableSize];
-    struct Uid {
-        uint8_t uid[rdm::kUidSize];
-    };
-    Uid tod_[kTableSize];
+    uint64_t tod_[kTableSize];
+    uint8_t next_uid_[rdm::kUidSize];
 };
 } // namespace rdm
 
@@ -46,6 +46,12 @@ namespace responder {
 inline constexpr uint32_t kPacketSpacing = 200;    ///< Min 176us, Max 2ms
 inline constexpr uint32_t kDataDirectionDelay = 4; ///<
 } // namespace responder
+namespace controller {
+///< 3.2.1 Responder Packet Timing, time in µs after the end of the request
+inline constexpr uint32_t kResponseLostTimeOut = 2800;          ///< Request to lost response
+inline constexpr uint32_t kDiscoveryResponseLostTimeOut = 5800; ///< DISC_UNIQUE_BRANCH to lost response
+inline constexpr uint32_t kBroadcastPacketSpacing = 176;        ///< Broadcast request to any other packet
+} // namespace controller
 
 inline constexpr uint16_t kRootDevice = 0;
 ///< 5 Device Addressing
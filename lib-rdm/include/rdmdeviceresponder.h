@@ -32,11 +32,13 @@
 #include "firmware/debug/debug_debug.h"
 #include "board.h"
 #include "rdmconst.h"
+#include "rdm_e120.h"
 #include "rdmdevice.h"
 #include "rdmidentify.h"
 #include "rdmpersonality.h"
 #include "rdmsensors.h"
 #include "rdmsubdevices.h"
+#include "rdmqueuedmessage.h"
 #include "dmxnode.h"
 #include "dmxnode_outputtype.h"
 
@@ -98,6 +100,7 @@ class RDMDeviceResponder
 
         rdm_device.SetSubdeviceCount(kSubDevices);
         rdm_device.SetSensorCount(sensors_.GetCount());
+        sensors_.Start();
 
         memcpy(&sub_device_info_, rdm_device.GetDeviceInfo(), sizeof(struct rdm::device::Info));
 
@@ -142,6 +145,8 @@ class RDMDeviceResponder
             length = rdm::device::kLabelMaxLength;
         }
 
+        rdm::queued::ChangedPid(E120_DEVICE_LABEL, sub_device);
+
         if (sub_device != rdm::kRootDevice)
         {
             sub_devices_.SetLabel(sub_device, label, length);
@@ -242,6 +247,8 @@ class RDMDeviceResponder
 
         if (dmx_start_address == 0 || dmx_start_address > dmxnode::kUniverseSize) return;
 
+        rdm::queued::ChangedPid(E120_DMX_START_ADDRESS, sub_device);
+
         if (sub_device != rdm::kRootDevice)
         {
             sub_devices_.SetDmxStartAddress(sub_device, dmx_start_address);
@@ -333,6 +340,10 @@ class RDMDeviceResponder
     {
         assert(personality >= 1);
 
+        // The footprint and the start address can change with the personality
+        rdm::queued::ChangedPid(E120_DMX_PERSONALITY, sub_device);
+        rdm::queued::ChangedPid(E120_DEVICE_INFO, sub_device);
+
         if (sub_device != rdm::kRootDevice)
         {
             sub_devices_.SetPersonalityCurrent(sub_device, personality);
@@ -0,0 +1,114 @@
+/**
+ * @file rdmdiscovery.h
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RDMDISCOVERY_H_
+#define RDMDISCOVERY_H_
+
+/**
+ * Controller side discovery, E1.20 7 Discovery Method.
+ * Binary search with DISC_UNIQUE_BRANCH, DISC_MUTE and DISC_UN_MUTE.
+ * Run() never waits for a response; it is called from the main loop and
+ * advances the state machine when a response has been received or has timed out.
+ */
+
+#include <cstdint>
+
+#include "rdmmessage.h"
+#include "rdm_tod.h"
+
+namespace rdm::discovery {
+enum class State {
+    kIdle,
+    kUnMute,
+    kMuteKnown,
+    kUniqueBranch,
+    kMute,
+    kFinished
+};
+
+inline constexpr uint64_t kUidLowest = 0;
+inline constexpr uint64_t kUidHighest = 0xFFFFFFFFFFFE; ///< 0xFFFFFFFFFFFF is the broadcast UID
+inline constexpr uint32_t kUnMuteCount = 3;             ///< Broadcasts are not acknowledged
+inline constexpr uint32_t kMuteRetries = 3;
+inline constexpr uint32_t kBranchStackSize = 50; ///< 48 levels of splitting + the initial branch
+} // namespace rdm::discovery
+
+class RDMDiscovery {
+   public:
+    void SetSrcUid(const uint8_t* src_uid) { message_.SetSrcUid(src_uid); }
+
+    /**
+     * The TOD is cleared, all devices are un-muted and the complete UID range is searched.
+     */
+    void Full(uint32_t port_index, rdm::Tod* tod);
+    /**
+     * The known devices are muted, the devices not responding are removed from the TOD.
+     * Then the search only finds the devices added since the previous discovery.
+     */
+    void Incremental(uint32_t port_index, rdm::Tod* tod);
+    void Stop();
+
+    void Run();
+
+    [[nodiscard]] bool IsRunning() const { return (state_ != rdm::discovery::State::kIdle) && (state_ != rdm::discovery::State::kFinished); }
+    [[nodiscard]] bool IsFinished() const { return state_ == rdm::discovery::State::kFinished; }
+
+   private:
+    struct Branch {
+        uint64_t lower;
+        uint64_t upper;
+    };
+
+    void Start(uint32_t port_index, rdm::Tod* tod);
+    void Transmit(uint8_t command_class, uint16_t param_id, const uint8_t* uid, const uint8_t* param_data, uint8_t param_data_length, uint32_t time_out);
+    void TransmitUnMute();
+    void TransmitMute(const uint8_t* uid);
+    void TransmitUniqueBranch();
+    void Handle(const uint8_t* response, uint32_t length);
+    void HandleMuteKnown(const uint8_t* response);
+    void HandleUniqueBranch(const uint8_t* response, uint32_t length);
+    void HandleMute(const uint8_t* response);
+    void Split();
+    bool Push(uint64_t lower, uint64_t upper);
+    void NextBranch();
+    bool IsMuteResponse(const uint8_t* response, const uint8_t* uid) const;
+
+   private:
+    RdmMessage message_;
+    rdm::Tod* tod_{nullptr};
+    uint32_t port_index_{0};
+    uint32_t time_out_{0};
+    uint32_t count_{0};
+    uint32_t tod_index_{0};
+    uint32_t branch_stack_top_{0};
+    rdm::discovery::State state_{rdm::discovery::State::kIdle};
+    bool is_waiting_{false};
+    bool is_incremental_{false};
+    uint8_t uid_[rdm::kUidSize];
+    Branch branch_{};
+    Branch branch_stack_[rdm::discovery::kBranchStackSize];
+};
+
+#endif // RDMDISCOVERY_H_
@@ -75,6 +75,7 @@ bool HandleManufactureerPidSet(bool is_broadcast, uint16_t pid, const ParameterD
                                struct ManufacturerParamData* out, uint16_t& reason);
 
 inline constexpr uint32_t kDeviceDescriptionMaxLength = 32;
+inline constexpr uint32_t kDeferredMax = 4; ///< Must be power of 2
 
 template <uint16_t Value> struct ManufacturerPid
 {
@@ -88,6 +89,23 @@ template <typename T, size_t N> struct Description
     static_assert(kSize <= kDeviceDescriptionMaxLength, "Description is too long");
     static constexpr char const* kValue = T::kDescription;
 };
+
+/**
+ * The manufacturer PIDs are found with a binary search.
+ * PARAMETER_DESCRIPTIONS[] must be sorted by PID, without duplicates.
+ */
+template <size_t N> constexpr bool IsSortedByPid(const ParameterDescription (&parameter_descriptions)[N])
+{
+    for (size_t i = 1; i < N; i++)
+    {
+        if (__builtin_bswap16(parameter_descriptions[i - 1].pid) >= __builtin_bswap16(parameter_descriptions[i].pid))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
 } // namespace rdmhandler
 
 class RDMHandler
@@ -107,17 +125,33 @@ class RDMHandler
 
     void HandleData(const uint8_t* data_in, uint8_t* data_out, Type type = Type::kTypeRdm);
 
+#if defined(ENABLE_RDM_QUEUED_MSG)
+    /**
+     * Runs one deferred SET from the superloop, the result is posted in the queued messages.
+     */
+    void Run();
+#endif
+
    private:
     explicit RDMHandler();
     void CreateRespondMessage(uint8_t type, uint16_t reason);
     void RespondMessageAck();
     void RespondMessageNack(uint16_t reason);
+#if defined(ENABLE_RDM_QUEUED_MSG)
+    void RespondMessageAckTimer(uint32_t estimated_millis);
+    /**
+     * The work of a slow SET is done in Run(), outside of the responder timing.
+     * @return false when the work cannot be deferred, the caller does the work itself.
+     */
+    bool Defer(bool (RDMHandler::*handler)(uint16_t subdevice, uint16_t& reason), bool is_broadcast, uint16_t subdevice, uint32_t estimated_millis);
+#endif
     void HandleString(const char* sring, uint32_t length);
     void Handlers(Type type, bool broadcast, uint8_t command_class, uint16_t param_id, uint8_t param_data_length, uint16_t subdevice);
 
     // Get
 #if defined(ENABLE_RDM_QUEUED_MSG)
     void GetQueuedMessage(uint16_t subdevice);
+    void GetStatusMessages(uint16_t subdevice);
 #endif
     void GetSupportedParameters(uint16_t subdevice);
 #if defined(CONFIG_RDM_ENABLE_MANUFACTURER_PIDS)
@@ -171,6 +205,7 @@ class RDMHandler
     // Set
     void SetDeviceLabel(bool is_broadcast, uint16_t subdevice);
     void SetFactoryDefaults(bool is_broadcast, uint16_t subdevice);
+    bool FactoryDefaults(uint16_t subdevice, uint16_t& reason);
     void SetLanguage(bool is_broadcast, uint16_t subdevice);
     void SetPersonality(bool is_broadcast, uint16_t subdevice);
     void SetDmxStartAddress(bool is_broadcast, uint16_t subdevice);
@@ -188,6 +223,7 @@ class RDMHandler
 #endif
 #if defined(ENABLE_RDM_PRESET_PLAYBACK)
     void SetPresetPlayback(bool is_broadcast, uint16_t subdevice);
+    void SetCapturePreset(bool is_broadcast, uint16_t subdevice);
 #endif
 #if defined(CONFIG_RDM_ENABLE_MANUFACTURER_PIDS) && defined(CONFIG_RDM_MANUFACTURER_PIDS_SET)
     void SetManufacturerPid(bool is_broadcast, uint16_t subdevice);
@@ -212,6 +248,19 @@ class RDMHandler
     uint8_t* m_pRdmDataOut{nullptr};
 #if defined(ENABLE_RDM_QUEUED_MSG)
     RDMQueuedMessage m_RDMQueuedMessage;
+
+    struct Deferred
+    {
+        bool (RDMHandler::*pHandler)(uint16_t subdevice, uint16_t& reason);
+        uint16_t nPid;
+        uint16_t nSubDevice;
+        bool bIsBroadcast;
+    };
+
+    Deferred deferred_[rdmhandler::kDeferredMax];
+    uint32_t deferred_head_{0};
+    uint32_t deferred_tail_{0};
+    bool is_defer_allowed_{false};
 #endif
 
     struct PidDefinition
@@ -232,11 +281,17 @@ class RDMHandler
 
     static const PidDefinition PID_DEFINITIONS[];
     static const PidDefinition PID_DEFINITIONS_SUB_DEVICES[];
+    static const PidDefinition* FindPidDefinition(uint16_t pid);
 #if defined(CONFIG_RDM_ENABLE_MANUFACTURER_PIDS)
     static const PidDefinition PID_DEFINITION_MANUFACTURER_GENERAL;
     static const rdmhandler::ParameterDescription PARAMETER_DESCRIPTIONS[];
 
     uint32_t GetParameterDescriptionCount() const;
+    /**
+     * @param pid swapped, as in PARAMETER_DESCRIPTIONS[]
+     * @return index in PARAMETER_DESCRIPTIONS[], or GetParameterDescriptionCount() when not found
+     */
+    uint32_t FindParameterDescription(uint16_t pid) const;
     void CopyParameterDescription(uint32_t nIndex, uint8_t* pParamData)
     {
         const auto kSize = sizeof(struct rdmhandler::ParameterDescription) - sizeof(const char*) - sizeof(const uint8_t);
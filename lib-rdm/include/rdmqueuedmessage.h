@@ -2,7 +2,7 @@
  * @file rdmqueuedmessage.h
  *
  */
-/* Copyright (C) 2018-2025 by Arjan van Vught mailto:info@gd32-dmx.org
+/* Copyright (C) 2018-2026 by Arjan van Vught mailto:info@gd32-dmx.org
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -26,38 +26,126 @@
 #ifndef RDMQUEUEDMESSAGE_H_
 #define RDMQUEUEDMESSAGE_H_
 
+/**
+ * E1.20 10.3 Queued and Status Messages
+ * The queue holds the PIDs which have changed, not the responses. The response is
+ * created when the controller collects the message, so it always has the current value.
+ * Status messages are kept in a separate FIFO and are reported with STATUS_MESSAGES.
+ */
+
 #include <cstdint>
 
-#include "e120.h"
+namespace rdm::queued
+{
+inline constexpr uint32_t kMessagesMax = 32;       ///< Changed PIDs, must be power of 2
+inline constexpr uint32_t kStatusMessagesMax = 16; ///< Must be power of 2
+inline constexpr uint32_t kParamDataMax = 2;       ///< The GET argument, for example the sensor number
+inline constexpr uint32_t kStatusMessageSize = 9;  ///< 10.3.2 Get Status Messages
+
+static_assert((kMessagesMax & (kMessagesMax - 1)) == 0);
+static_assert((kStatusMessagesMax & (kStatusMessagesMax - 1)) == 0);
 
-struct TRdmQueuedMessage
+struct Message
 {
-    uint8_t command_class;     ///< 21
-    uint8_t param_id[2];       ///< 22, 23
-    uint8_t param_data_length; ///< 24	PDL	Range 0 to 231
-    uint8_t param_data[231];   ///< 25,,,,	PD	6.2.3 Message Length
+    uint16_t pid;
+    uint16_t sub_device;
+    uint8_t command_class; ///< E120_SET_COMMAND is the result of a SET answered with ACK_TIMER
+    uint8_t response_type;
+    uint8_t param_data_length;
+    uint8_t param_data[kParamDataMax]; ///< For a NACK the reason code
 };
 
+struct StatusMessage
+{
+    uint16_t sub_device;
+    uint8_t status_type;
+    uint16_t message_id;
+    int16_t data_value1;
+    int16_t data_value2;
+};
+} // namespace rdm::queued
+
 class RDMQueuedMessage
 {
    public:
     RDMQueuedMessage();
-    ~RDMQueuedMessage();
 
     uint8_t GetMessageCount() const;
 
-    void Handler(uint8_t* rdm_data);
+    /**
+     * A PID already in the queue for the same sub-device is not added again.
+     */
+    bool AddChangedPid(uint16_t pid, uint16_t sub_device, const uint8_t* param_data = nullptr, uint8_t param_data_length = 0);
+    /**
+     * The final response of a SET which has been answered with ACK_TIMER.
+     */
+    bool AddResponse(uint16_t pid, uint16_t sub_device, uint8_t command_class, uint8_t response_type, uint16_t reason = 0);
+    bool AddStatusMessage(uint16_t sub_device, uint8_t status_type, uint16_t message_id, int16_t data_value1, int16_t data_value2);
+
+    bool Pop(rdm::queued::Message& message);
+    bool GetLast(rdm::queued::Message& message) const;
+
+    /**
+     * Copies the status messages with a severity of at least status_type, these are removed.
+     * @return the number of bytes copied
+     */
+    uint32_t CopyStatusMessages(uint8_t status_type, uint8_t* param_data, uint32_t max_length);
 
-    bool Add(const struct TRdmQueuedMessage* msg);
+    /**
+     * A change made with an RDM SET is already known by the controller.
+     */
+    void SetIgnoreChangedPid(bool ignore_changed_pid) { ignore_changed_pid_ = ignore_changed_pid; }
+
+    static RDMQueuedMessage* Get() { return s_this; }
 
    private:
-    void Copy(struct TRdmMessage* rdm_message, uint32_t index);
+    bool Add(const rdm::queued::Message& message);
 
    private:
-    uint8_t message_count_{0};
-    bool is_never_queued_{true};
+    rdm::queued::Message messages_[rdm::queued::kMessagesMax];
+    rdm::queued::StatusMessage status_messages_[rdm::queued::kStatusMessagesMax];
+    rdm::queued::Message last_message_{};
+    uint32_t messages_head_{0};
+    uint32_t messages_tail_{0};
+    uint32_t status_messages_head_{0};
+    uint32_t status_messages_tail_{0};
+    bool has_last_message_{false};
+    bool ignore_changed_pid_{false};
 
-    struct TRdmQueuedMessage* queued_message_;
+    inline static RDMQueuedMessage* s_this;
 };
 
-#endif  // RDMQUEUEDMESSAGE_H_
+namespace rdm::queued
+{
+/*
+ * To be called where a change is made, also from outside RDM.
+ * Nothing is queued when ENABLE_RDM_QUEUED_MSG is not defined.
+ */
+inline void ChangedPid([[maybe_unused]] uint16_t pid, [[maybe_unused]] uint16_t sub_device, [[maybe_unused]] const uint8_t* param_data = nullptr,
+                       [[maybe_unused]] uint8_t param_data_length = 0)
+{
+#if defined(ENABLE_RDM_QUEUED_MSG)
+    auto* queued_message = RDMQueuedMessage::Get();
+
+    if (queued_message != nullptr)
+    {
+        queued_message->AddChangedPid(pid, sub_device, param_data, param_data_length);
+    }
+#endif
+}
+
+inline void Status([[maybe_unused]] uint16_t sub_device, [[maybe_unused]] uint8_t status_type, [[maybe_unused]] uint16_t message_id,
+                   [[maybe_unused]] int16_t data_value1, [[maybe_unused]] int16_t data_value2)
+{
+#if defined(ENABLE_RDM_QUEUED_MSG)
+    auto* queued_message = RDMQueuedMessage::Get();
+
+    if (queued_message != nullptr)
+    {
+        queued_message->AddStatusMessage(sub_device, status_type, message_id, data_value1, data_value2);
+    }
+#endif
+}
+} // namespace rdm::queued
+
+#endif // RDMQUEUEDMESSAGE_H_
@@ -83,7 +83,16 @@ class RDMResponder final : DMXReceiver, public RDMDeviceResponder {
                     is_sub_device_active = false;
                 }
             } else if (dmx_data_in != nullptr) {
-                RdmSubDevices::Get()->SetData(dmx_data_in, static_cast<uint16_t>(length));
+                auto* sub_devices = RdmSubDevices::Get();
+                dmx::ChangedSlots changed;
+                // Always called, it keeps the previous frame up to date
+                const auto kIsChanged = DMXReceiver::GetDmxChangedSlots(changed);
+
+                if (sub_devices->IsUpdateAll()) {
+                    sub_devices->SetData(dmx_data_in, static_cast<uint16_t>(length));
+                } else if (kIsChanged) {
+                    sub_devices->SetData(dmx_data_in, static_cast<uint16_t>(length), changed.first, changed.last);
+                }
                 if (!is_sub_device_active) {
                     RdmSubDevices::Get()->Start();
                     is_sub_device_active = true;
@@ -92,6 +101,11 @@ class RDMResponder final : DMXReceiver, public RDMDeviceResponder {
         }
 #endif
 
+#if defined(ENABLE_RDM_QUEUED_MSG)
+        // The SETs answered with ACK_TIMER
+        RDMHandler::Instance().Run();
+#endif
+
         const auto* rdm_data_in = Rdm::Receive(0);
 
         if (rdm_data_in == nullptr) [[likely]] {
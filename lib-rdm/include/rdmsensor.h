@@ -31,7 +31,9 @@
 #include <cassert>
 #include <algorithm>
 
+#include "rdmconst.h"
 #include "rdm_e120.h"
+#include "rdmqueuedmessage.h"
 
 #include "firmware/debug/debug_debug.h"
 
@@ -148,13 +150,28 @@ class RDMSensor {
 
     const struct rdm::sensor::Defintion* GetDefintion() { return &sensor_defintion_; }
 
-    const struct rdm::sensor::Values* GetValues() {
-        DEBUG_ENTRY();
+    /**
+     * Reads the sensor. With background sampling this is called from the RDMSensors timer only.
+     */
+    void Sample() {
         const auto kValue = this->GetValue();
 
-        sensor_values_.present = kValue;
+        UpdatePresent(kValue);
         sensor_values_.lowest_detected = std::min(sensor_values_.lowest_detected, kValue);
         sensor_values_.highest_detected = std::max(sensor_values_.highest_detected, kValue);
+    }
+
+    /**
+     * When sampled, the RDM requests are answered with the cached values.
+     */
+    void SetSampled(bool is_sampled) { is_sampled_ = is_sampled; }
+
+    const struct rdm::sensor::Values* GetValues() {
+        DEBUG_ENTRY();
+
+        if (!is_sampled_) {
+            Sample();
+        }
 
         DEBUG_EXIT();
         return &sensor_values_;
@@ -162,24 +179,26 @@ class RDMSensor {
 
     void SetValues() {
         DEBUG_ENTRY();
-        const auto kValue = this->GetValue();
 
-        sensor_values_.present = kValue;
-        sensor_values_.lowest_detected = kValue;
-        sensor_values_.highest_detected = kValue;
-        sensor_values_.recorded = kValue;
+        if (!is_sampled_) {
+            UpdatePresent(this->GetValue());
+        }
+
+        sensor_values_.lowest_detected = sensor_values_.present;
+        sensor_values_.highest_detected = sensor_values_.present;
+        sensor_values_.recorded = sensor_values_.present;
 
         DEBUG_EXIT();
     }
 
     void Record() {
         DEBUG_ENTRY();
-        const auto kValue = this->GetValue();
 
-        sensor_values_.present = kValue;
-        sensor_values_.recorded = kValue;
-        sensor_values_.lowest_detected = std::min(sensor_values_.lowest_detected, kValue);
-        sensor_values_.highest_detected = std::max(sensor_values_.highest_detected, kValue);
+        if (!is_sampled_) {
+            Sample();
+        }
+
+        sensor_values_.recorded = sensor_values_.present;
 
         DEBUG_EXIT();
     }
@@ -187,8 +206,29 @@ class RDMSensor {
     virtual bool Initialize() = 0;
     virtual int16_t GetValue() = 0;
 
+   private:
+    /*
+     * Leaving or returning to the normal range is reported with a queued message.
+     */
+    void UpdatePresent(int16_t value) {
+        sensor_values_.present = value;
+
+        const auto kIsOutOfRange = (value < sensor_defintion_.normal_min) || (value > sensor_defintion_.normal_max);
+
+        if (kIsOutOfRange == is_out_of_range_) {
+            return;
+        }
+
+        is_out_of_range_ = kIsOutOfRange;
+
+        rdm::queued::ChangedPid(E120_SENSOR_VALUE, rdm::kRootDevice, &sensor_, 1);
+        rdm::queued::Status(rdm::kRootDevice, kIsOutOfRange ? E120_STATUS_WARNING : E120_STATUS_WARNING_CLEARED, E120_STS_SENS_OUT_RANGE, sensor_, value);
+    }
+
    private:
     uint8_t sensor_;
+    bool is_out_of_range_{false};
+    bool is_sampled_{false};
     rdm::sensor::Defintion sensor_defintion_;
     rdm::sensor::Values sensor_values_;
 };
@@ -31,6 +31,7 @@
 
 #include "configurationstore.h"
 #include "rdmsensor.h"
+#include "softwaretimers.h"
 #include "firmware/debug/debug_debug.h"
 
 #if !defined(__APPLE__)
@@ -49,6 +50,19 @@
 #include "json/rdmsensorsparams.h"
 #endif
 
+namespace rdm::sensors {
+/*
+ * Each sensor is read once per interval. The reads are spread over the interval,
+ * one sensor per timer tick, so that a slow I2C sensor does not block the superloop.
+ */
+inline constexpr uint32_t kSampleIntervalMillis =
+#if defined(CONFIG_RDM_SENSORS_SAMPLE_INTERVAL_MS)
+    CONFIG_RDM_SENSORS_SAMPLE_INTERVAL_MS;
+#else
+    1000;
+#endif
+} // namespace rdm::sensors
+
 class RDMSensors {
    public:
     RDMSensors() {
@@ -74,6 +88,8 @@ class RDMSensors {
 
     ~RDMSensors() {
         DEBUG_ENTRY();
+        Stop();
+
         for (uint32_t i = 0; i < count_; i++) {
             if (rdm_sensor_[i] != nullptr) {
                 delete rdm_sensor_[i];
@@ -101,6 +117,13 @@ class RDMSensors {
         assert(rdm_sensor != nullptr);
         rdm_sensor_[count_++] = rdm_sensor;
 
+        if (s_timer_id != kTimerIdNone) {
+            rdm_sensor->Sample();
+            rdm_sensor->SetSampled(true);
+            // A full pass over all sensors still takes sample_interval_millis_
+            SoftwareTimerChange(s_timer_id, TickMillis(sample_interval_millis_));
+        }
+
         DEBUG_PRINTF("count_=%u", count_);
         DEBUG_EXIT();
         return true;
@@ -142,13 +165,77 @@ class RDMSensors {
 
     RDMSensor* GetSensor(uint8_t sensor) { return rdm_sensor_[sensor]; }
 
+    /**
+     * Starts the background sampling. The cache is filled first, then the
+     * RDM requests are answered from the cache.
+     */
+    void Start(uint32_t sample_interval_millis = rdm::sensors::kSampleIntervalMillis) {
+        DEBUG_ENTRY();
+
+        if ((count_ == 0) || (s_timer_id != kTimerIdNone)) {
+            DEBUG_EXIT();
+            return;
+        }
+
+        for (uint32_t i = 0; i < count_; i++) {
+            rdm_sensor_[i]->Sample();
+            rdm_sensor_[i]->SetSampled(true);
+        }
+
+        sample_index_ = 0;
+        sample_interval_millis_ = sample_interval_millis;
+        s_timer_id = SoftwareTimerAdd(TickMillis(sample_interval_millis), SampleTimer);
+
+        DEBUG_PRINTF("s_timer_id=%d", static_cast<int>(s_timer_id));
+        DEBUG_EXIT();
+    }
+
+    void Stop() {
+        if (s_timer_id == kTimerIdNone) {
+            return;
+        }
+
+        SoftwareTimerDelete(s_timer_id);
+
+        for (uint32_t i = 0; i < count_; i++) {
+            rdm_sensor_[i]->SetSampled(false);
+        }
+    }
+
+    void SetSampleInterval(uint32_t sample_interval_millis) {
+        sample_interval_millis_ = sample_interval_millis;
+
+        if (s_timer_id != kTimerIdNone) {
+            SoftwareTimerChange(s_timer_id, TickMillis(sample_interval_millis));
+        }
+    }
+
     static RDMSensors* Get() { return s_this; }
 
+   private:
+    uint32_t TickMillis(uint32_t sample_interval_millis) const {
+        const auto kTick = sample_interval_millis / count_;
+        return kTick == 0 ? 1 : kTick;
+    }
+
+    static void SampleTimer([[maybe_unused]] TimerHandle_t handle) {
+        auto* sensors = s_this;
+
+        sensors->rdm_sensor_[sensors->sample_index_]->Sample();
+
+        if (++sensors->sample_index_ == sensors->count_) {
+            sensors->sample_index_ = 0;
+        }
+    }
+
    private:
     RDMSensor** rdm_sensor_{nullptr};
+    uint32_t sample_interval_millis_{rdm::sensors::kSampleIntervalMillis};
     uint8_t count_{0};
+    uint8_t sample_index_{0};
 
     inline static RDMSensors* s_this;
+    inline static TimerHandle_t s_timer_id{kTimerIdNone};
 };
 
 #endif // RDMSENSORS_H_
@@ -133,6 +133,7 @@ class RdmSubDevices {
         assert((sub_device != 0) && (sub_device <= count_));
         assert(rdm_sub_device_[sub_device - 1] != nullptr);
         rdm_sub_device_[sub_device - 1]->SetPersonalityCurrent(personality);
+        is_update_all_ = true;
     }
 
     // E120_DEVICE_LABEL			0x0082
@@ -171,6 +172,8 @@ class RdmSubDevices {
                 rdm_sub_device_[i]->SetFactoryDefaults();
             }
         }
+
+        is_update_all_ = true;
     }
 
     // E120_DMX_START_ADDRESS		0x00F0
@@ -184,6 +187,7 @@ class RdmSubDevices {
         assert((sub_device != 0) && (sub_device <= count_));
         assert(rdm_sub_device_[sub_device - 1] != nullptr);
         rdm_sub_device_[sub_device - 1]->SetDmxStartAddress(dmx_start_address);
+        is_update_all_ = true;
     }
 
     void Start() {
@@ -193,6 +197,7 @@ class RdmSubDevices {
                 rdm_sub_device_[i]->Start();
             }
         }
+        is_update_all_ = true;
         DEBUG_EXIT();
     }
 
@@ -203,10 +208,13 @@ class RdmSubDevices {
                 rdm_sub_device_[i]->Stop();
             }
         }
+        is_update_all_ = true;
         DEBUG_ENTRY();
     }
 
     void SetData(const uint8_t* data, uint32_t length) {
+        is_update_all_ = false;
+
         for (uint32_t i = 0; i < count_; i++) {
             if (rdm_sub_device_[i] != nullptr) {
                 if (length >= (static_cast<uint16_t>(rdm_sub_device_[i]->GetDmxStartAddress() + rdm_sub_device_[i]->GetDmxFootPrint()) - 1U)) {
@@ -216,11 +224,39 @@ class RdmSubDevices {
         }
     }
 
+    /**
+     * Only the sub-devices with a footprint overlapping the changed slots first..last are updated.
+     * The data does not include the start code, so data[0] is slot 1.
+     */
+    void SetData(const uint8_t* data, uint32_t length, uint32_t first, uint32_t last) {
+        for (uint32_t i = 0; i < count_; i++) {
+            if (rdm_sub_device_[i] != nullptr) {
+                const uint32_t kFirst = rdm_sub_device_[i]->GetDmxStartAddress();
+                const uint32_t kLast = kFirst + rdm_sub_device_[i]->GetDmxFootPrint() - 1U;
+
+                if ((kFirst > last) || (kLast < first)) {
+                    continue;
+                }
+
+                if (length >= kLast) {
+                    rdm_sub_device_[i]->Data(data, length);
+                }
+            }
+        }
+    }
+
+    /**
+     * After Start/Stop, a start address, personality or factory defaults change,
+     * the next SetData must be the one without the changed slots.
+     */
+    bool IsUpdateAll() const { return is_update_all_; }
+
     static RdmSubDevices* Get() { return s_this; }
 
    private:
     RDMSubDevice** rdm_sub_device_{nullptr};
     uint16_t count_{0};
+    bool is_update_all_{true};
 
     static inline RdmSubDevices* s_this;
 };
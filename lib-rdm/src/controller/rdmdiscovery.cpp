@@ -0,0 +1,327 @@
+/**
+ * @file rdmdiscovery.cpp
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#include "rdmdiscovery.h"
+#include "rdmmessage.h"
+#include "rdm_tod.h"
+#include "rdmconst.h"
+#include "e120.h"
+#include "rdm_e120.h"
+#include "dmxconst.h"
+#include "timing.h"
+#include "firmware/debug/debug_debug.h"
+
+using rdm::discovery::State;
+
+namespace {
+/*
+ * 7.5 Discovery Unique Branch Message
+ * Response: up to 7 x 0xFE, 0xAA, 12 bytes encoded UID, 4 bytes encoded checksum.
+ * Each byte is sent twice: once OR'ed with 0xAA and once OR'ed with 0x55.
+ * When more than one responder answers, the collision is detected by the checksum.
+ */
+bool DecodeUniqueBranchResponse(const uint8_t* response, uint32_t length, uint8_t* uid) {
+    constexpr uint32_t kEncodedSize = (rdm::kUidSize * 2) + 4;
+    uint32_t index = 0;
+
+    while ((index < 7) && (index < length) && (response[index] == 0xFE)) {
+        index++;
+    }
+
+    // A short or truncated response would be decoded from the previous buffer contents
+    if ((length < (index + 1 + kEncodedSize)) || (response[index++] != 0xAA)) {
+        return false;
+    }
+
+    const auto* encoded = &response[index];
+    uint16_t checksum = 0;
+
+    for (uint32_t i = 0; i < (rdm::kUidSize * 2); i++) {
+        checksum = static_cast<uint16_t>(checksum + encoded[i]);
+    }
+
+    for (uint32_t i = 0; i < rdm::kUidSize; i++) {
+        uid[i] = encoded[i * 2] & encoded[i * 2 + 1];
+    }
+
+    const auto kChecksum = static_cast<uint16_t>(((encoded[12] & encoded[13]) << 8) | (encoded[14] & encoded[15]));
+
+    return kChecksum == checksum;
+}
+
+constexpr uint32_t RequestMicros(uint32_t message_length) {
+    return rdm::transmit::kBreakTimeTypical + rdm::transmit::kMabTimeTypical + (message_length + rdm::kMessageChecksumSize) * dmx::kSlotTime;
+}
+} // namespace
+
+void RDMDiscovery::Full(uint32_t port_index, rdm::Tod* tod) {
+    DEBUG_ENTRY();
+
+    tod->Reset();
+
+    is_incremental_ = false;
+    Start(port_index, tod);
+
+    DEBUG_EXIT();
+}
+
+void RDMDiscovery::Incremental(uint32_t port_index, rdm::Tod* tod) {
+    DEBUG_ENTRY();
+
+    is_incremental_ = true;
+    Start(port_index, tod);
+
+    DEBUG_EXIT();
+}
+
+void RDMDiscovery::Stop() {
+    state_ = State::kIdle;
+    is_waiting_ = false;
+}
+
+void RDMDiscovery::Start(uint32_t port_index, rdm::Tod* tod) {
+    assert(port_index < dmx::config::max::kPorts);
+    assert(tod != nullptr);
+
+    port_index_ = port_index;
+    tod_ = tod;
+    count_ = 0;
+    branch_stack_top_ = 0;
+    is_waiting_ = false;
+
+    state_ = State::kUnMute;
+    TransmitUnMute();
+}
+
+/**
+ * Non-blocking. A response is handled as soon as it has been received,
+ * otherwise when the time-out has elapsed the response is considered lost.
+ */
+void RDMDiscovery::Run() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    if (!is_waiting_) {
+        return;
+    }
+
+    uint32_t length;
+    const auto* response = Rdm::Receive(port_index_, length);
+
+    if ((response == nullptr) && ((timing::Micros() - message_.TransmitMicros()) < time_out_)) {
+        return;
+    }
+
+    is_waiting_ = false;
+
+    Handle(response, length);
+}
+
+void RDMDiscovery::Transmit(uint8_t command_class, uint16_t param_id, const uint8_t* uid, const uint8_t* param_data, uint8_t param_data_length, uint32_t time_out) {
+    // Discard anything left over from the previous request
+    static_cast<void>(Rdm::Receive(port_index_));
+
+    message_.SetDstUid(uid);
+    message_.SetCc(command_class);
+    message_.SetPid(param_id);
+    message_.SetPd(param_data, param_data_length);
+    message_.Transmit(port_index_);
+
+    time_out_ = RequestMicros(rdm::kMessageMinimumSize + param_data_length) + time_out;
+    is_waiting_ = true;
+}
+
+void RDMDiscovery::TransmitUnMute() {
+    Transmit(E120_DISCOVERY_COMMAND, E120_DISC_UN_MUTE, rdm::kUidAll, nullptr, 0, rdm::controller::kBroadcastPacketSpacing);
+}
+
+void RDMDiscovery::TransmitMute(const uint8_t* uid) {
+    Transmit(E120_DISCOVERY_COMMAND, E120_DISC_MUTE, uid, nullptr, 0, rdm::controller::kResponseLostTimeOut);
+}
+
+void RDMDiscovery::TransmitUniqueBranch() {
+    uint8_t param_data[rdm::kUidSize * 2];
+
+    rdm::Tod::FromKey(branch_.lower, &param_data[0]);
+    rdm::Tod::FromKey(branch_.upper, &param_data[rdm::kUidSize]);
+
+    Transmit(E120_DISCOVERY_COMMAND, E120_DISC_UNIQUE_BRANCH, rdm::kUidAll, param_data, sizeof(param_data), rdm::controller::kDiscoveryResponseLostTimeOut);
+}
+
+void RDMDiscovery::Handle(const uint8_t* response, uint32_t length) {
+    switch (state_) {
+        case State::kUnMute:
+            if (++count_ < rdm::discovery::kUnMuteCount) {
+                TransmitUnMute();
+                return;
+            }
+
+            if (is_incremental_ && (tod_->UidCount() != 0)) {
+                state_ = State::kMuteKnown;
+                tod_index_ = tod_->UidCount() - 1;
+                count_ = 0;
+                tod_->CopyUidEntry(tod_index_, uid_);
+                TransmitMute(uid_);
+                return;
+            }
+
+            Push(rdm::discovery::kUidLowest, rdm::discovery::kUidHighest);
+            NextBranch();
+            break;
+        case State::kMuteKnown:
+            HandleMuteKnown(response);
+            break;
+        case State::kUniqueBranch:
+            HandleUniqueBranch(response, length);
+            break;
+        case State::kMute:
+            HandleMute(response);
+            break;
+        default:
+            assert(false && "switch");
+            break;
+    }
+}
+
+/*
+ * Incremental discovery: a known device which does not respond to DISC_MUTE has gone.
+ * The TOD is walked backwards, so that a Delete does not move the entries still to be checked.
+ */
+void RDMDiscovery::HandleMuteKnown(const uint8_t* response) {
+    if (!IsMuteResponse(response, uid_)) {
+        if (++count_ < rdm::discovery::kMuteRetries) {
+            TransmitMute(uid_);
+            return;
+        }
+
+        DEBUG_PRINTF("Lost %.2x%.2x:%.2x%.2x%.2x%.2x", uid_[0], uid_[1], uid_[2], uid_[3], uid_[4], uid_[5]);
+        tod_->Delete(uid_);
+    }
+
+    if (tod_index_ != 0) {
+        tod_index_--;
+        count_ = 0;
+        tod_->CopyUidEntry(tod_index_, uid_);
+        TransmitMute(uid_);
+        return;
+    }
+
+    Push(rdm::discovery::kUidLowest, rdm::discovery::kUidHighest);
+    NextBranch();
+}
+
+void RDMDiscovery::HandleUniqueBranch(const uint8_t* response, uint32_t length) {
+    if (response == nullptr) {
+        // No un-muted device in this branch
+        NextBranch();
+        return;
+    }
+
+    if (DecodeUniqueBranchResponse(response, length, uid_)) {
+        const auto kKey = rdm::Tod::ToKey(uid_);
+
+        if ((kKey >= branch_.lower) && (kKey <= branch_.upper)) {
+            state_ = State::kMute;
+            count_ = 0;
+            TransmitMute(uid_);
+            return;
+        }
+    }
+
+    // Collision
+    Split();
+}
+
+void RDMDiscovery::HandleMute(const uint8_t* response) {
+    if (IsMuteResponse(response, uid_)) {
+        DEBUG_PRINTF("Found %.2x%.2x:%.2x%.2x%.2x%.2x", uid_[0], uid_[1], uid_[2], uid_[3], uid_[4], uid_[5]);
+        tod_->AddUid(uid_);
+        // There can be more devices in the same branch
+        Push(branch_.lower, branch_.upper);
+        NextBranch();
+        return;
+    }
+
+    if (++count_ < rdm::discovery::kMuteRetries) {
+        TransmitMute(uid_);
+        return;
+    }
+
+    // The decoded UID was the result of a collision with a valid checksum, or the device does not mute.
+    Split();
+}
+
+void RDMDiscovery::Split() {
+    if (branch_.lower != branch_.upper) {
+        const auto kMiddle = branch_.lower + ((branch_.upper - branch_.lower) / 2);
+        // The lower half is searched first
+        Push(kMiddle + 1, branch_.upper);
+        Push(branch_.lower, kMiddle);
+    }
+
+    NextBranch();
+}
+
+bool RDMDiscovery::Push(uint64_t lower, uint64_t upper) {
+    if (branch_stack_top_ == rdm::discovery::kBranchStackSize) {
+        assert(false && "kBranchStackSize");
+        return false;
+    }
+
+    branch_stack_[branch_stack_top_].lower = lower;
+    branch_stack_[branch_stack_top_].upper = upper;
+    branch_stack_top_++;
+
+    return true;
+}
+
+void RDMDiscovery::NextBranch() {
+    if (branch_stack_top_ == 0) {
+        state_ = State::kFinished;
+        DEBUG_PRINTF("Finished: %u", static_cast<unsigned int>(tod_->UidCount()));
+        return;
+    }
+
+    branch_ = branch_stack_[--branch_stack_top_];
+    state_ = State::kUniqueBranch;
+
+    TransmitUniqueBranch();
+}
+
+bool RDMDiscovery::IsMuteResponse(const uint8_t* response, const uint8_t* uid) const {
+    if ((response == nullptr) || (response[0] != E120_SC_RDM)) {
+        return false;
+    }
+
+    const auto* message = reinterpret_cast<const struct TRdmMessage*>(response);
+
+    return (message->command_class == E120_DISCOVERY_COMMAND_RESPONSE) && (message->param_id[0] == (E120_DISC_MUTE >> 8)) && (message->param_id[1] == (E120_DISC_MUTE & 0xFF)) &&
+           (memcmp(message->source_uid, uid, rdm::kUidSize) == 0);
+}
@@ -63,7 +63,7 @@ enum class ResetMode : uint8_t {
     kCold = 0xFF ///< A cold reset is the equivalent of removing and reapplying power to the device.
 };
 
-const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[]{
+constexpr RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[]{
     {E120_DEVICE_INFO, &RDMHandler::GetDeviceInfo, nullptr, 0, false, true, true},
     {E120_DEVICE_MODEL_DESCRIPTION, &RDMHandler::GetDeviceModelDescription, nullptr, 0, true, true, true},
     {E120_MANUFACTURER_LABEL, &RDMHandler::GetManufacturerLabel, nullptr, 0, true, true, true},
@@ -73,7 +73,8 @@ const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[]{
     {E120_RESET_DEVICE, nullptr, &RDMHandler::SetResetDevice, 0, true, true, true},
 #if defined(RDM_RESPONDER)
 #if defined(ENABLE_RDM_QUEUED_MSG)
-    {E120_QUEUED_MESSAGE, &RDMHandler::GetQueuedMessage, nullptr, 1, true, false},
+    {E120_QUEUED_MESSAGE, &RDMHandler::GetQueuedMessage, nullptr, 1, true, true, false},
+    {E120_STATUS_MESSAGES, &RDMHandler::GetStatusMessages, nullptr, 1, true, true, false},
 #endif
     {E120_SUPPORTED_PARAMETERS, &RDMHandler::GetSupportedParameters, nullptr, 0, false, true, false},
 #if defined(CONFIG_RDM_ENABLE_MANUFACTURER_PIDS)
@@ -105,6 +106,7 @@ const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[]{
     {E120_SELF_TEST_DESCRIPTION, &RDMHandler::GetSelfTestDescription, nullptr, 1, true, true, false},
 #endif
 #if defined(ENABLE_RDM_PRESET_PLAYBACK)
+    {E120_CAPTURE_PRESET, nullptr, &RDMHandler::SetCapturePreset, 0, true, true, false},
     {E120_PRESET_PLAYBACK, &RDMHandler::GetPresetPlayback, &RDMHandler::SetPresetPlayback, 0, true, true, false},
 #endif
     {E137_1_IDENTIFY_MODE, &RDMHandler::GetIdentifyMode, &RDMHandler::SetIdentifyMode, 0, true, true, false},
@@ -126,7 +128,7 @@ const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[]{
 #endif
 };
 
-const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS_SUB_DEVICES[]{
+constexpr RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS_SUB_DEVICES[]{
     {E120_DEVICE_INFO, &RDMHandler::GetDeviceInfo, nullptr, 0, true, true, false},
     {E120_SOFTWARE_VERSION_LABEL, &RDMHandler::GetSoftwareVersionLabel, nullptr, 0, true, true, false},
     {E120_IDENTIFY_DEVICE, &RDMHandler::GetIdentifyDevice, &RDMHandler::SetIdentifyDevice, 0, true, true, false},
@@ -139,7 +141,144 @@ const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS_SUB_DEVICES[]{
 #endif
 };
 
+namespace
+{
+/*
+ * The PID tables are indexed at compile time.
+ * The PIDs are sorted for a binary search, the index refers to the PID table entry.
+ */
+template <size_t N> struct PidIndex
+{
+    uint16_t pid[N];
+    uint8_t index[N];
+};
+
+template <typename T, size_t N> constexpr PidIndex<N> MakePidIndex(const T (&pid_definitions)[N])
+{
+    static_assert(N <= 256, "The index is uint8_t");
+
+    PidIndex<N> pid_index{};
+
+    for (size_t i = 0; i < N; i++)
+    {
+        auto j = i;
+
+        while ((j > 0) && (pid_index.pid[j - 1] > pid_definitions[i].nPid))
+        {
+            pid_index.pid[j] = pid_index.pid[j - 1];
+            pid_index.index[j] = pid_index.index[j - 1];
+            j--;
+        }
+
+        pid_index.pid[j] = pid_definitions[i].nPid;
+        pid_index.index[j] = static_cast<uint8_t>(i);
+    }
+
+    return pid_index;
+}
+
+template <size_t N> constexpr bool IsUnique(const PidIndex<N>& pid_index)
+{
+    for (size_t i = 1; i < N; i++)
+    {
+        if (pid_index.pid[i - 1] == pid_index.pid[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * The SUPPORTED_PARAMETERS response is prebuilt at compile time, big endian.
+ */
+template <size_t N> struct SupportedParameters
+{
+    uint8_t data[2 * N];
+    uint32_t length;
+};
+
+template <typename T, size_t N> constexpr SupportedParameters<N> MakeSupportedParameters(const T (&pid_definitions)[N])
+{
+    SupportedParameters<N> supported_parameters{};
+
+    for (size_t i = 0; i < N; i++)
+    {
+        if (pid_definitions[i].bIncludeInSupportedParams)
+        {
+            supported_parameters.data[supported_parameters.length++] = static_cast<uint8_t>(pid_definitions[i].nPid >> 8);
+            supported_parameters.data[supported_parameters.length++] = static_cast<uint8_t>(pid_definitions[i].nPid);
+        }
+    }
+
+    return supported_parameters;
+}
+} // namespace
+
+const RDMHandler::PidDefinition* RDMHandler::FindPidDefinition(uint16_t pid)
+{
+    static constexpr auto kPidIndex = MakePidIndex(PID_DEFINITIONS);
+    static_assert(IsUnique(kPidIndex), "Duplicate PID in PID_DEFINITIONS");
+    constexpr auto kEntries = sizeof(kPidIndex.pid) / sizeof(kPidIndex.pid[0]);
+
+    uint32_t lower = 0;
+    uint32_t upper = kEntries;
+
+    while (lower < upper)
+    {
+        const auto kMiddle = lower + (upper - lower) / 2;
+        const auto kMiddlePid = kPidIndex.pid[kMiddle];
+
+        if (kMiddlePid == pid)
+        {
+            return &PID_DEFINITIONS[kPidIndex.index[kMiddle]];
+        }
+
+        if (kMiddlePid < pid)
+        {
+            lower = kMiddle + 1;
+        }
+        else
+        {
+            upper = kMiddle;
+        }
+    }
+
+    return nullptr;
+}
+
 #if defined(CONFIG_RDM_ENABLE_MANUFACTURER_PIDS)
+uint32_t RDMHandler::FindParameterDescription(uint16_t pid) const
+{
+    const auto kCount = GetParameterDescriptionCount();
+    const auto kPid = __builtin_bswap16(pid);
+    uint32_t lower = 0;
+    uint32_t upper = kCount;
+
+    while (lower < upper)
+    {
+        const auto kMiddle = lower + (upper - lower) / 2;
+        const auto kMiddlePid = __builtin_bswap16(PARAMETER_DESCRIPTIONS[kMiddle].pid);
+
+        if (kMiddlePid == kPid)
+        {
+            return kMiddle;
+        }
+
+        if (kMiddlePid < kPid)
+        {
+            lower = kMiddle + 1;
+        }
+        else
+        {
+            upper = kMiddle;
+        }
+    }
+
+    return kCount;
+}
+
 #if defined(CONFIG_RDM_MANUFACTURER_PIDS_SET)
 const RDMHandler::PidDefinition RDMHandler::PID_DEFINITION_MANUFACTURER_GENERAL{
     0, &RDMHandler::GetManufacturerPid, &RDMHandler::SetManufacturerPid, 0, false, true, false};
@@ -185,7 +324,11 @@ void RDMHandler::CreateRespondMessage(uint8_t type, uint16_t reason)
     out->start_code = E120_SC_RDM;
     out->sub_start_code = in->sub_start_code;
     out->transaction_number = in->transaction_number;
-    out->message_count = 0; // rdm_queued_message_get_count(); //FIXME rdm_queued_message_get_count
+#if defined(ENABLE_RDM_QUEUED_MSG)
+    out->message_count = m_RDMQueuedMessage.GetMessageCount();
+#else
+    out->message_count = 0;
+#endif
     out->sub_device[0] = in->sub_device[0];
     out->sub_device[1] = in->sub_device[1];
     out->command_class = static_cast<uint8_t>(in->command_class + 1);
@@ -242,6 +385,69 @@ void RDMHandler::RespondMessageNack(uint16_t reason)
     CreateRespondMessage(E120_RESPONSE_TYPE_NACK_REASON, reason);
 }
 
+#if defined(ENABLE_RDM_QUEUED_MSG)
+/*
+ * E1.20 6.3.2 The estimated response time is in tenths of a second.
+ */
+void RDMHandler::RespondMessageAckTimer(uint32_t estimated_millis)
+{
+    const auto kEstimated = (estimated_millis + 99U) / 100U;
+    CreateRespondMessage(E120_RESPONSE_TYPE_ACK_TIMER, static_cast<uint16_t>(kEstimated > UINT16_MAX ? UINT16_MAX : kEstimated));
+}
+
+bool RDMHandler::Defer(bool (RDMHandler::*handler)(uint16_t, uint16_t&), bool is_broadcast, uint16_t sub_device, uint32_t estimated_millis)
+{
+    // LLRP has no queued messages
+    if (!is_defer_allowed_ || ((deferred_head_ - deferred_tail_) == rdmhandler::kDeferredMax))
+    {
+        return false;
+    }
+
+    const auto* in = reinterpret_cast<struct TRdmMessageNoSc*>(m_pRdmDataIn);
+    auto& deferred = deferred_[deferred_head_ & (rdmhandler::kDeferredMax - 1)];
+
+    deferred.pHandler = handler;
+    deferred.nPid = static_cast<uint16_t>((in->param_id[0] << 8) + in->param_id[1]);
+    deferred.nSubDevice = sub_device;
+    deferred.bIsBroadcast = is_broadcast;
+
+    deferred_head_++;
+
+    if (!is_broadcast)
+    {
+        RespondMessageAckTimer(estimated_millis);
+    }
+
+    return true;
+}
+
+void RDMHandler::Run()
+{
+    if (deferred_head_ == deferred_tail_) [[likely]]
+    {
+        return;
+    }
+
+    const auto kDeferred = deferred_[deferred_tail_ & (rdmhandler::kDeferredMax - 1)];
+    deferred_tail_++;
+
+    DEBUG_PRINTF("pid=0x%.4x", kDeferred.nPid);
+
+    uint16_t reason = 0;
+
+    // As for a SET handled directly, the side effects are not queued
+    m_RDMQueuedMessage.SetIgnoreChangedPid(true);
+    const auto kIsAck = (this->*(kDeferred.pHandler))(kDeferred.nSubDevice, reason);
+    m_RDMQueuedMessage.SetIgnoreChangedPid(false);
+
+    if (!kDeferred.bIsBroadcast)
+    {
+        m_RDMQueuedMessage.AddResponse(kDeferred.nPid, kDeferred.nSubDevice, E120_SET_COMMAND,
+                                       kIsAck ? E120_RESPONSE_TYPE_ACK : E120_RESPONSE_TYPE_NACK_REASON, reason);
+    }
+}
+#endif
+
 /**
  * @param pRdmDataIn RDM with no Start Code
  * @param pRdmDataOut RDM with the Start Code or it is Discover Message
@@ -436,34 +642,21 @@ void RDMHandler::Handlers(Type type, bool bIsBroadcast, uint8_t nCommandClass, u
         return;
     }
 
-    PidDefinition const* pid_handler = nullptr;
+    const auto* pid_handler = FindPidDefinition(nParamId);
     auto is_rdm = false;
     auto is_rdm_net = false;
 
-    for (auto& defintion : PID_DEFINITIONS)
+    if (pid_handler)
     {
-        if (defintion.nPid == nParamId)
-        {
-            pid_handler = &defintion;
-            is_rdm = defintion.bRDM;
-            is_rdm_net = defintion.bRDMNet;
-            break;
-        }
+        is_rdm = pid_handler->bRDM;
+        is_rdm_net = pid_handler->bRDMNet;
     }
-
 #if defined(CONFIG_RDM_ENABLE_MANUFACTURER_PIDS)
-    if (!pid_handler)
+    else if (FindParameterDescription(__builtin_bswap16(nParamId)) != GetParameterDescriptionCount())
     {
-        for (uint32_t i = 0; i < GetParameterDescriptionCount(); i++)
-        {
-            if (PARAMETER_DESCRIPTIONS[i].pid == __builtin_bswap16(nParamId))
-            {
-                pid_handler = &PID_DEFINITION_MANUFACTURER_GENERAL;
-                is_rdm = true;
-                is_rdm_net = false;
-                break;
-            }
-        }
+        pid_handler = &PID_DEFINITION_MANUFACTURER_GENERAL;
+        is_rdm = true;
+        is_rdm_net = false;
     }
 #endif
 
@@ -537,66 +730,170 @@ void RDMHandler::Handlers(Type type, bool bIsBroadcast, uint8_t nCommandClass, u
             return;
         }
 
+#if defined(ENABLE_RDM_QUEUED_MSG)
+        is_defer_allowed_ = (type == Type::kTypeRdm);
+        // The controller doing the SET already knows about the change
+        m_RDMQueuedMessage.SetIgnoreChangedPid(true);
+        (this->*(pid_handler->pSetHandler))(bIsBroadcast, sub_device);
+        m_RDMQueuedMessage.SetIgnoreChangedPid(false);
+#else
         (this->*(pid_handler->pSetHandler))(bIsBroadcast, sub_device);
+#endif
     }
 
     DEBUG_EXIT();
 }
 
 #if defined(ENABLE_RDM_QUEUED_MSG)
+/*
+ * E1.20 10.3.1 Get Queued Message
+ * The queue holds the PIDs which have changed. The request is re-written into a GET for
+ * that PID and handed to its GET handler, so the response has the current value.
+ * The result of a SET answered with ACK_TIMER is returned as the SET response.
+ */
 void RDMHandler::GetQueuedMessage([[maybe_unused]] uint16_t sub_device)
 {
-    m_RDMQueuedMessage.Handler(m_pRdmDataOut);
-    RespondMessageAck();
+    const auto* in = reinterpret_cast<struct TRdmMessageNoSc*>(m_pRdmDataIn);
+    const auto kStatusType = in->param_data[0];
+
+    if ((kStatusType == E120_STATUS_NONE) || (kStatusType > E120_STATUS_ERROR))
+    {
+        RespondMessageNack(E120_NR_DATA_OUT_OF_RANGE);
+        return;
+    }
+
+    rdm::queued::Message message;
+    bool is_available;
+
+    if (kStatusType == E120_STATUS_GET_LAST_MESSAGE)
+    {
+        is_available = m_RDMQueuedMessage.GetLast(message);
+    }
+    else
+    {
+        is_available = m_RDMQueuedMessage.Pop(message);
+    }
+
+    if (!is_available)
+    {
+        // 10.3.1 When no messages are queued, a STATUS_MESSAGES response is returned
+        message.pid = E120_STATUS_MESSAGES;
+        message.sub_device = 0;
+        message.command_class = E120_GET_COMMAND;
+        message.param_data_length = 1;
+        message.param_data[0] = (kStatusType == E120_STATUS_GET_LAST_MESSAGE) ? static_cast<uint8_t>(E120_STATUS_NONE) : kStatusType;
+    }
+    else if (message.pid == E120_STATUS_MESSAGES)
+    {
+        message.param_data_length = 1;
+        message.param_data[0] = (kStatusType == E120_STATUS_GET_LAST_MESSAGE) ? static_cast<uint8_t>(E120_STATUS_ADVISORY) : kStatusType;
+    }
+
+    const auto* pid_handler = FindPidDefinition(message.pid);
+
+    if ((message.command_class == E120_GET_COMMAND) && ((pid_handler == nullptr) || (pid_handler->pGetHandler == nullptr)))
+    {
+        RespondMessageNack(E120_NR_HARDWARE_FAULT);
+        return;
+    }
+
+    struct TRdmMessageNoSc request;
+    memcpy(&request, in, sizeof(struct TRdmMessageNoSc) - e120::kPdlSize - 2U);
+
+    request.sub_device[0] = static_cast<uint8_t>(message.sub_device >> 8);
+    request.sub_device[1] = static_cast<uint8_t>(message.sub_device);
+    request.command_class = message.command_class;
+    request.param_id[0] = static_cast<uint8_t>(message.pid >> 8);
+    request.param_id[1] = static_cast<uint8_t>(message.pid);
+
+    auto* data_in = m_pRdmDataIn;
+    m_pRdmDataIn = reinterpret_cast<uint8_t*>(&request);
+
+    if (message.command_class == E120_GET_COMMAND)
+    {
+        request.param_data_length = message.param_data_length;
+        memcpy(request.param_data, message.param_data, message.param_data_length);
+
+        (this->*(pid_handler->pGetHandler))(message.sub_device);
+    }
+    else
+    {
+        request.param_data_length = 0;
+
+        if (message.response_type == E120_RESPONSE_TYPE_ACK)
+        {
+            reinterpret_cast<struct TRdmMessage*>(m_pRdmDataOut)->param_data_length = 0;
+            RespondMessageAck();
+        }
+        else
+        {
+            RespondMessageNack(static_cast<uint16_t>((message.param_data[0] << 8) | message.param_data[1]));
+        }
+    }
+
+    m_pRdmDataIn = data_in;
 }
-#endif
 
-#if defined(RDM_RESPONDER)
-void RDMHandler::GetSupportedParameters(uint16_t sub_device)
+/*
+ * E1.20 10.3.2 Get Status Messages
+ */
+void RDMHandler::GetStatusMessages([[maybe_unused]] uint16_t sub_device)
 {
-    uint8_t nSupportedParams = 0;
-    PidDefinition* pid_definitions;
-    uint32_t table_size = 0;
+    const auto* in = reinterpret_cast<struct TRdmMessageNoSc*>(m_pRdmDataIn);
+    auto* out = reinterpret_cast<struct TRdmMessage*>(m_pRdmDataOut);
+    const auto kStatusType = in->param_data[0];
 
-    if (sub_device != 0)
+    if (kStatusType > E120_STATUS_ERROR)
+    {
+        RespondMessageNack(E120_NR_DATA_OUT_OF_RANGE);
+        return;
+    }
+
+    // The reported status messages are not kept, so STATUS_GET_LAST_MESSAGE returns an empty list
+    if ((kStatusType == E120_STATUS_NONE) || (kStatusType == E120_STATUS_GET_LAST_MESSAGE))
     {
-        pid_definitions = const_cast<PidDefinition*>(&PID_DEFINITIONS_SUB_DEVICES[0]);
-        table_size = sizeof(PID_DEFINITIONS_SUB_DEVICES) / sizeof(PID_DEFINITIONS_SUB_DEVICES[0]);
+        out->param_data_length = 0;
     }
     else
     {
-        pid_definitions = const_cast<PidDefinition*>(&PID_DEFINITIONS[0]);
-        table_size = sizeof(PID_DEFINITIONS) / sizeof(PID_DEFINITIONS[0]);
+        out->param_data_length = static_cast<uint8_t>(m_RDMQueuedMessage.CopyStatusMessages(kStatusType, out->param_data, e120::kPdlSize));
     }
 
+    RespondMessageAck();
+}
+#endif
+
+#if defined(RDM_RESPONDER)
+void RDMHandler::GetSupportedParameters(uint16_t sub_device)
+{
+    static constexpr auto kSupportedParameters = MakeSupportedParameters(PID_DEFINITIONS);
+    static constexpr auto kSupportedParametersSubDevices = MakeSupportedParameters(PID_DEFINITIONS_SUB_DEVICES);
+
     auto* out = reinterpret_cast<struct TRdmMessage*>(m_pRdmDataOut);
-    uint32_t j = 0;
+    uint32_t length;
 
-    for (uint32_t i = 0; i < table_size; i++)
+    if (sub_device != 0)
     {
-        if (pid_definitions[i].bIncludeInSupportedParams)
-        {
-            nSupportedParams++;
-            out->param_data[j + j] = static_cast<uint8_t>(pid_definitions[i].nPid >> 8);
-            out->param_data[j + j + 1] = static_cast<uint8_t>(pid_definitions[i].nPid);
-            j++;
-        }
+        memcpy(out->param_data, kSupportedParametersSubDevices.data, kSupportedParametersSubDevices.length);
+        length = kSupportedParametersSubDevices.length;
+    }
+    else
+    {
+        memcpy(out->param_data, kSupportedParameters.data, kSupportedParameters.length);
+        length = kSupportedParameters.length;
     }
 
 #if defined(CONFIG_RDM_ENABLE_MANUFACTURER_PIDS)
     const auto nSupportedParamsManufacturer = GetParameterDescriptionCount();
 
-    nSupportedParams = static_cast<uint8_t>(nSupportedParams + nSupportedParamsManufacturer);
-
     for (uint32_t i = 0; i < nSupportedParamsManufacturer; i++)
     {
-        out->param_data[j + j] = static_cast<uint8_t>(PARAMETER_DESCRIPTIONS[i].pid); ///< The PIDs are swapped
-        out->param_data[j + j + 1] = static_cast<uint8_t>(PARAMETER_DESCRIPTIONS[i].pid >> 8);
-        j++;
+        memcpy(&out->param_data[length], &PARAMETER_DESCRIPTIONS[i].pid, 2); ///< The PIDs are swapped
+        length += 2;
     }
 #endif
 
-    out->param_data_length = static_cast<uint8_t>(2 * nSupportedParams);
+    out->param_data_length = static_cast<uint8_t>(length);
 
     RespondMessageAck();
 }
@@ -611,18 +908,16 @@ void RDMHandler::GetParameterDescription([[maybe_unused]] uint16_t sub_device) {
         return;
     }
 
-    const auto nSupportedParamsManufacturer = GetParameterDescriptionCount();
+    const auto nIndex = FindParameterDescription(nPid);
 
-    for (uint32_t i = 0; i < nSupportedParamsManufacturer; i++) {
-        if (PARAMETER_DESCRIPTIONS[i].pid == nPid) {
-            auto* pRdmDataOut = reinterpret_cast<struct TRdmMessage*>(m_pRdmDataOut);
+    if (nIndex != GetParameterDescriptionCount()) {
+        auto* pRdmDataOut = reinterpret_cast<struct TRdmMessage*>(m_pRdmDataOut);
 
-            pRdmDataOut->param_data_length = PARAMETER_DESCRIPTIONS[i].pdl;
-            CopyParameterDescription(i, pRdmDataOut->param_data);
+        pRdmDataOut->param_data_length = PARAMETER_DESCRIPTIONS[nIndex].pdl;
+        CopyParameterDescription(nIndex, pRdmDataOut->param_data);
 
-            RespondMessageAck();
-            return;
-        }
+        RespondMessageAck();
+        return;
     }
 
     RespondMessageNack(E120_NR_DATA_OUT_OF_RANGE);
@@ -655,13 +950,13 @@ void RDMHandler::SetManufacturerPid(bool is_broadcast, [[maybe_unused]] uint16_t
     struct rdmhandler::ManufacturerParamData pOut = {0, pRdmDataOut->param_data};
     uint16_t nReason = E120_NR_UNKNOWN_PID;
 
-    for (uint32_t nIndex = 0; nIndex < GetParameterDescriptionCount(); nIndex++) {
-        if (PARAMETER_DESCRIPTIONS[nIndex].pid == nPid) {
-            if (rdmhandler::HandleManufactureerPidSet(is_broadcast, nPid, PARAMETER_DESCRIPTIONS[nIndex], &pIn, &pOut, nReason)) {
-                pRdmDataOut->param_data_length = pOut.nPdl;
-                RespondMessageAck();
-                return;
-            }
+    const auto nIndex = FindParameterDescription(nPid);
+
+    if (nIndex != GetParameterDescriptionCount()) {
+        if (rdmhandler::HandleManufactureerPidSet(is_broadcast, nPid, PARAMETER_DESCRIPTIONS[nIndex], &pIn, &pOut, nReason)) {
+            pRdmDataOut->param_data_length = pOut.nPdl;
+            RespondMessageAck();
+            return;
         }
     }
 
@@ -706,12 +1001,16 @@ void RDMHandler::SetFactoryDefaults(bool is_broadcast, [[maybe_unused]] uint16_t
         return;
     }
 
-#if defined(RDM_RESPONDER)
-    RDMDeviceResponder::Get()->SetFactoryDefaults();
-#else
-    rdm::device::Device::Instance().SetFactoryDefaults();
+#if defined(ENABLE_RDM_QUEUED_MSG)
+    // Erasing and writing the configuration does not fit in the responder timing
+    if (Defer(&RDMHandler::FactoryDefaults, is_broadcast, sub_device, 1000)) {
+        return;
+    }
 #endif
 
+    uint16_t reason;
+    FactoryDefaults(sub_device, reason);
+
     if (is_broadcast) {
         return;
     }
@@ -722,6 +1021,15 @@ void RDMHandler::SetFactoryDefaults(bool is_broadcast, [[maybe_unused]] uint16_t
     RespondMessageAck();
 }
 
+bool RDMHandler::FactoryDefaults([[maybe_unused]] uint16_t sub_device, [[maybe_unused]] uint16_t& reason) {
+#if defined(RDM_RESPONDER)
+    RDMDeviceResponder::Get()->SetFactoryDefaults();
+#else
+    rdm::device::Device::Instance().SetFactoryDefaults();
+#endif
+    return true;
+}
+
 #if defined(RDM_RESPONDER)
 void RDMHandler::GetProductDetailIdList([[maybe_unused]] uint16_t sub_device) {
     const auto kProductDetail = rdm::device::Device::Instance().GetProductDetail();
@@ -1552,6 +1860,31 @@ void RDMHandler::SetPresetPlayback([[maybe_unused]] bool is_broadcast, [[maybe_u
 
     RespondMessageAck();
 }
+
+void RDMHandler::SetCapturePreset([[maybe_unused]] bool is_broadcast, [[maybe_unused]] uint16_t sub_device)
+{
+    auto* pRdmDataIn = reinterpret_cast<struct TRdmMessageNoSc*>(m_pRdmDataIn);
+
+    if (pRdmDataIn->param_data_length != 8)
+    {
+        RespondMessageNack(E120_NR_FORMAT_ERROR);
+        return;
+    }
+
+    // The fade and wait times are not stored per scene, the playback uses SetSceneFadeMillis()
+    const auto nScene = static_cast<uint16_t>((pRdmDataIn->param_data[0] << 8) + pRdmDataIn->param_data[1]);
+
+    if (!rdm::preset_playback::Capture(nScene))
+    {
+        RespondMessageNack(E120_NR_DATA_OUT_OF_RANGE);
+        return;
+    }
+
+    auto* pRdmDataOut = reinterpret_cast<struct TRdmMessage*>(m_pRdmDataOut);
+    pRdmDataOut->param_data_length = 0;
+
+    RespondMessageAck();
+}
 #endif // ENABLE_RDM_PRESET_PLAYBACK
 
 void RDMHandler::GetSlotInfo(uint16_t sub_device)
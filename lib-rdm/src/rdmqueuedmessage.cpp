@@ -2,7 +2,7 @@
  * @file rdmqueuedmessage.cpp
  *
  */
-/* Copyright (C) 2017-2025 by Arjan van Vught mailto:info@gd32-dmx.org
+/* Copyright (C) 2017-2026 by Arjan van Vught mailto:info@gd32-dmx.org
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -24,93 +24,224 @@
  */
 
 #include <cstdint>
+#include <cstring>
 #include <cassert>
 
 #include "rdmqueuedmessage.h"
-#include "rdmconst.h"
-#include "e120.h"
 #include "rdm_e120.h"
 
+using rdm::queued::kMessagesMax;
+using rdm::queued::kStatusMessagesMax;
+
+namespace
+{
+/*
+ * The *_CLEARED status types (0x12-0x14) are not ordered by their code,
+ * E1.20 10.3.2 treats them as advisory.
+ */
+constexpr uint8_t Severity(uint8_t status_type)
+{
+    if ((status_type >= E120_STATUS_ADVISORY_CLEARED) && (status_type <= E120_STATUS_ERROR_CLEARED))
+    {
+        return E120_STATUS_ADVISORY;
+    }
+
+    return status_type;
+}
+} // namespace
+
 RDMQueuedMessage::RDMQueuedMessage()
 {
-    queued_message_ = new TRdmQueuedMessage[rdm::kMessageCountMax];
-    assert(queued_message_ != nullptr);
+    assert(s_this == nullptr);
+    s_this = this;
 }
 
-RDMQueuedMessage::~RDMQueuedMessage()
+uint8_t RDMQueuedMessage::GetMessageCount() const
 {
-    assert(queued_message_ == nullptr);
-    delete[] queued_message_;
+    const auto kCount = messages_head_ - messages_tail_;
+    return static_cast<uint8_t>(kCount > 255 ? 255 : kCount);
 }
 
-void RDMQueuedMessage::Copy(struct TRdmMessage* rdm_message, uint32_t index)
+bool RDMQueuedMessage::Add(const rdm::queued::Message& message)
 {
-    assert(index < rdm::kMessageCountMax);
+    for (auto i = messages_tail_; i != messages_head_; i++)
+    {
+        const auto& queued = messages_[i & (kMessagesMax - 1)];
 
-    rdm_message->command_class = queued_message_[index].command_class;
-    rdm_message->param_id[0] = queued_message_[index].param_id[0];
-    rdm_message->param_id[1] = queued_message_[index].param_id[1];
-    rdm_message->param_data_length = queued_message_[index].param_data_length;
+        if ((queued.pid == message.pid) && (queued.sub_device == message.sub_device) && (queued.command_class == message.command_class) &&
+            (queued.response_type == message.response_type) && (queued.param_data_length == message.param_data_length) &&
+            (memcmp(queued.param_data, message.param_data, message.param_data_length) == 0))
+        {
+            return true;
+        }
+    }
 
-    for (uint32_t i = 0; i < rdm_message->param_data_length; i++)
+    if ((messages_head_ - messages_tail_) == kMessagesMax)
     {
-        rdm_message->param_data[i] = queued_message_[index].param_data[i];
+        return false;
     }
+
+    messages_[messages_head_ & (kMessagesMax - 1)] = message;
+    messages_head_++;
+
+    return true;
 }
 
-uint8_t RDMQueuedMessage::GetMessageCount() const
+bool RDMQueuedMessage::AddChangedPid(uint16_t pid, uint16_t sub_device, const uint8_t* param_data, uint8_t param_data_length)
 {
-    return message_count_;
+    if (ignore_changed_pid_)
+    {
+        return true;
+    }
+
+    assert(param_data_length <= rdm::queued::kParamDataMax);
+
+    rdm::queued::Message message;
+
+    message.pid = pid;
+    message.sub_device = sub_device;
+    message.command_class = E120_GET_COMMAND;
+    message.response_type = E120_RESPONSE_TYPE_ACK;
+    message.param_data_length = param_data_length;
+
+    if (param_data_length != 0)
+    {
+        memcpy(message.param_data, param_data, param_data_length);
+    }
+
+    return Add(message);
 }
 
-void RDMQueuedMessage::Handler(uint8_t* rdm_data)
+bool RDMQueuedMessage::AddResponse(uint16_t pid, uint16_t sub_device, uint8_t command_class, uint8_t response_type, uint16_t reason)
 {
-    auto rdm_response = reinterpret_cast<struct TRdmMessage*>(rdm_data);
+    rdm::queued::Message message;
+
+    message.pid = pid;
+    message.sub_device = sub_device;
+    message.command_class = command_class;
+    message.response_type = response_type;
+    message.param_data_length = 2;
+    message.param_data[0] = static_cast<uint8_t>(reason >> 8);
+    message.param_data[1] = static_cast<uint8_t>(reason);
 
-    if (is_never_queued_)
+    return Add(message);
+}
+
+bool RDMQueuedMessage::AddStatusMessage(uint16_t sub_device, uint8_t status_type, uint16_t message_id, int16_t data_value1, int16_t data_value2)
+{
+    if ((status_messages_head_ - status_messages_tail_) == kStatusMessagesMax)
     {
-        rdm_response->slot16.response_type = E120_STATUS_MESSAGES;
-        rdm_response->param_data_length = 0;
+        // The oldest status message is dropped
+        status_messages_tail_++;
     }
-    else if (rdm_response->param_data[0] == E120_STATUS_GET_LAST_MESSAGE)
+
+    auto& status_message = status_messages_[status_messages_head_ & (kStatusMessagesMax - 1)];
+
+    status_message.sub_device = sub_device;
+    status_message.status_type = status_type;
+    status_message.message_id = message_id;
+    status_message.data_value1 = data_value1;
+    status_message.data_value2 = data_value2;
+
+    status_messages_head_++;
+
+    const auto kIgnoreChangedPid = ignore_changed_pid_;
+    ignore_changed_pid_ = false;
+    AddChangedPid(E120_STATUS_MESSAGES, 0);
+    ignore_changed_pid_ = kIgnoreChangedPid;
+
+    return true;
+}
+
+bool RDMQueuedMessage::Pop(rdm::queued::Message& message)
+{
+    if (messages_head_ == messages_tail_)
     {
-        Copy(rdm_response, message_count_);
+        return false;
     }
-    else
+
+    message = messages_[messages_tail_ & (kMessagesMax - 1)];
+    messages_tail_++;
+
+    last_message_ = message;
+    has_last_message_ = true;
+
+    return true;
+}
+
+bool RDMQueuedMessage::GetLast(rdm::queued::Message& message) const
+{
+    if (!has_last_message_)
     {
-        if (message_count_ != 0)
-        {
-            message_count_--;
-            Copy(rdm_response, message_count_);
-        }
-        else
-        {
-            rdm_response->slot16.response_type = E120_STATUS_MESSAGES;
-            rdm_response->param_data_length = 0;
-        }
+        return false;
     }
+
+    message = last_message_;
+    return true;
 }
 
-bool RDMQueuedMessage::Add(const struct TRdmQueuedMessage* queued_message)
+uint32_t RDMQueuedMessage::CopyStatusMessages(uint8_t status_type, uint8_t* param_data, uint32_t max_length)
 {
-    is_never_queued_ = false;
+    uint32_t length = 0;
+    auto tail = status_messages_tail_;
+    auto head = status_messages_tail_;
 
-    if (message_count_ != rdm::kMessageCountMax)
+    // The messages copied are removed, the others are kept in order
+    while ((tail != status_messages_head_) && ((length + rdm::queued::kStatusMessageSize) <= max_length))
     {
-        queued_message_[message_count_].command_class = queued_message->command_class;
-        queued_message_[message_count_].param_id[0] = queued_message->param_id[0];
-        queued_message_[message_count_].param_id[1] = queued_message->param_id[1];
-        queued_message_[message_count_].param_data_length = queued_message->param_data_length;
+        const auto& status_message = status_messages_[tail & (kStatusMessagesMax - 1)];
+        tail++;
 
-        for (uint32_t i = 0; i < queued_message->param_data_length; i++)
+        if (Severity(status_message.status_type) < Severity(status_type))
         {
-            queued_message_[message_count_].param_data[i] = queued_message->param_data[i];
+            status_messages_[head & (kStatusMessagesMax - 1)] = status_message;
+            head++;
+            continue;
         }
 
-        message_count_++;
+        auto* p = &param_data[length];
 
-        return true;
+        p[0] = static_cast<uint8_t>(status_message.sub_device >> 8);
+        p[1] = static_cast<uint8_t>(status_message.sub_device);
+        p[2] = status_message.status_type;
+        p[3] = static_cast<uint8_t>(status_message.message_id >> 8);
+        p[4] = static_cast<uint8_t>(status_message.message_id);
+        p[5] = static_cast<uint8_t>(static_cast<uint16_t>(status_message.data_value1) >> 8);
+        p[6] = static_cast<uint8_t>(status_message.data_value1);
+        p[7] = static_cast<uint8_t>(static_cast<uint16_t>(status_message.data_value2) >> 8);
+        p[8] = static_cast<uint8_t>(status_message.data_value2);
+
+        length += rdm::queued::kStatusMessageSize;
+    }
+
+    // Move the not inspected messages up
+    while (tail != status_messages_head_)
+    {
+        status_messages_[head & (kStatusMessagesMax - 1)] = status_messages_[tail & (kStatusMessagesMax - 1)];
+        head++;
+        tail++;
+    }
+
+    status_messages_head_ = head;
+
+    if (status_messages_head_ == status_messages_tail_)
+    {
+        // Nothing left to report with STATUS_MESSAGES
+        auto to = messages_tail_;
+
+        for (auto from = messages_tail_; from != messages_head_; from++)
+        {
+            const auto& message = messages_[from & (kMessagesMax - 1)];
+
+            if (message.pid != E120_STATUS_MESSAGES)
+            {
+                messages_[to & (kMessagesMax - 1)] = message;
+                to++;
+            }
+        }
+
+        messages_head_ = to;
     }
 
-    return false;
+    return length;
 }
@@ -0,0 +1,172 @@
+/**
+ * @file bench_rdm_tod.cpp
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Host benchmark of the lookup cost versus the table size.
+ * The sorted key array of rdm::Tod is compared with a linear memcmp scan,
+ * which is how the TOD was searched before.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+
+#include "rdm_tod.h"
+#include "rdmconst.h"
+
+namespace {
+uint32_t s_failed;
+
+#define CHECK(condition)                                                         \
+    do {                                                                         \
+        if (!(condition)) {                                                      \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            s_failed++;                                                          \
+        }                                                                        \
+    } while (false)
+
+constexpr uint32_t kTableSize = rdm::Tod::kTableSize;
+constexpr uint32_t kLookups = 1000000;
+
+rdm::Tod s_tod;
+uint8_t s_uids[kTableSize][rdm::kUidSize];
+uint8_t s_missing[kTableSize][rdm::kUidSize];
+uint32_t s_seed = 0x12345678;
+
+uint32_t Random() {
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 17;
+    s_seed ^= s_seed << 5;
+    return s_seed;
+}
+
+void RandomUid(uint8_t* uid) {
+    const auto kDevice = Random();
+    uid[0] = 0x7F;
+    uid[1] = static_cast<uint8_t>(Random());
+    memcpy(&uid[2], &kDevice, sizeof(kDevice));
+}
+
+bool LinearExist(const uint8_t* uid, uint32_t entries) {
+    for (uint32_t i = 0; i < entries; i++) {
+        if (memcmp(s_uids[i], uid, rdm::kUidSize) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename F> double NanosPerLookup(F lookup) {
+    const auto kStart = std::chrono::steady_clock::now();
+    uint32_t found = 0;
+
+    for (uint32_t i = 0; i < kLookups; i++) {
+        found += lookup(i) ? 1U : 0U;
+    }
+
+    const std::chrono::duration<double, std::nano> kElapsed = std::chrono::steady_clock::now() - kStart;
+
+    // Keep the lookups from being optimised away
+    if (found == UINT32_MAX) {
+        puts("");
+    }
+
+    return kElapsed.count() / kLookups;
+}
+
+void TestTod() {
+    s_tod.Reset();
+
+    for (uint32_t i = 0; i < kTableSize; i++) {
+        CHECK(s_tod.AddUid(s_uids[i]));
+    }
+
+    CHECK(s_tod.UidCount() == kTableSize);
+    CHECK(!s_tod.AddUid(s_missing[0]));
+
+    uint8_t previous[rdm::kUidSize];
+    s_tod.CopyUidEntry(0, previous);
+
+    for (uint32_t i = 1; i < kTableSize; i++) {
+        uint8_t uid[rdm::kUidSize];
+        CHECK(s_tod.CopyUidEntry(i, uid));
+        CHECK(memcmp(previous, uid, rdm::kUidSize) < 0);
+        memcpy(previous, uid, rdm::kUidSize);
+    }
+
+    CHECK(s_tod.Exist(s_uids[7]));
+    s_tod.Mute();
+    CHECK(s_tod.Delete(s_uids[3]));
+    CHECK(!s_tod.Exist(s_uids[3]));
+    CHECK(s_tod.Exist(s_uids[7]));
+    CHECK(s_tod.IsMuted());
+    CHECK(s_tod.AddUid(s_uids[3]));
+    CHECK(s_tod.Exist(s_uids[7]));
+    CHECK(s_tod.IsMuted());
+    CHECK(!s_tod.Exist(s_missing[0]));
+}
+
+void Benchmark() {
+    puts("entries  Exist hit  Exist miss  linear hit  linear miss  Delete+AddUid  [ns]");
+
+    for (uint32_t entries = 16; entries <= kTableSize; entries *= 2) {
+        s_tod.Reset();
+
+        for (uint32_t i = 0; i < entries; i++) {
+            s_tod.AddUid(s_uids[i]);
+        }
+
+        const auto kHit = NanosPerLookup([&](uint32_t i) { return s_tod.Exist(s_uids[i % entries]); });
+        const auto kMiss = NanosPerLookup([&](uint32_t i) { return s_tod.Exist(s_missing[i % entries]); });
+        const auto kLinearHit = NanosPerLookup([&](uint32_t i) { return LinearExist(s_uids[i % entries], entries); });
+        const auto kLinearMiss = NanosPerLookup([&](uint32_t i) { return LinearExist(s_missing[i % entries], entries); });
+        const auto kUpdate = NanosPerLookup([&](uint32_t i) {
+            const auto* uid = s_uids[i % entries];
+            return s_tod.Delete(uid) && s_tod.AddUid(uid);
+        });
+
+        printf("%7u  %9.1f  %10.1f  %10.1f  %11.1f  %13.1f\n", static_cast<unsigned>(entries), kHit, kMiss, kLinearHit, kLinearMiss, kUpdate);
+    }
+}
+} // namespace
+
+int main() {
+    for (uint32_t i = 0; i < kTableSize; i++) {
+        RandomUid(s_uids[i]);
+        RandomUid(s_missing[i]);
+    }
+
+    TestTod();
+
+    if (s_failed != 0) {
+        printf("%u check(s) failed\n", static_cast<unsigned>(s_failed));
+        return 1;
+    }
+
+    Benchmark();
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file test_rdm_queued_message.cpp
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Host test of the STATUS_MESSAGES filter of RDMQueuedMessage.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "rdmqueuedmessage.h"
+#include "rdm_e120.h"
+
+namespace {
+uint32_t s_failed;
+
+#define CHECK(condition)                                                         \
+    do {                                                                         \
+        if (!(condition)) {                                                      \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            s_failed++;                                                          \
+        }                                                                        \
+    } while (false)
+
+void TestStatusTypeFilter(RDMQueuedMessage& queued_message) {
+    constexpr uint8_t kTypes[] = {E120_STATUS_ADVISORY, E120_STATUS_WARNING, E120_STATUS_ERROR, E120_STATUS_ADVISORY_CLEARED, E120_STATUS_WARNING_CLEARED, E120_STATUS_ERROR_CLEARED};
+
+    for (uint32_t i = 0; i < sizeof(kTypes); i++) {
+        CHECK(queued_message.AddStatusMessage(0, kTypes[i], static_cast<uint16_t>(i), 0, 0));
+    }
+
+    uint8_t param_data[sizeof(kTypes) * rdm::queued::kStatusMessageSize];
+
+    // The cleared types are advisory, they are not reported for ERROR
+    auto length = queued_message.CopyStatusMessages(E120_STATUS_ERROR, param_data, sizeof(param_data));
+    CHECK(length == rdm::queued::kStatusMessageSize);
+    CHECK(param_data[2] == E120_STATUS_ERROR);
+
+    length = queued_message.CopyStatusMessages(E120_STATUS_WARNING, param_data, sizeof(param_data));
+    CHECK(length == rdm::queued::kStatusMessageSize);
+    CHECK(param_data[2] == E120_STATUS_WARNING);
+
+    // The remaining messages are kept in order
+    length = queued_message.CopyStatusMessages(E120_STATUS_ADVISORY, param_data, sizeof(param_data));
+    CHECK(length == 4 * rdm::queued::kStatusMessageSize);
+    CHECK(param_data[2] == E120_STATUS_ADVISORY);
+    CHECK(param_data[2 + 1 * rdm::queued::kStatusMessageSize] == E120_STATUS_ADVISORY_CLEARED);
+    CHECK(param_data[2 + 2 * rdm::queued::kStatusMessageSize] == E120_STATUS_WARNING_CLEARED);
+    CHECK(param_data[2 + 3 * rdm::queued::kStatusMessageSize] == E120_STATUS_ERROR_CLEARED);
+
+    CHECK(queued_message.CopyStatusMessages(E120_STATUS_ADVISORY, param_data, sizeof(param_data)) == 0);
+}
+} // namespace
+
+int main() {
+    RDMQueuedMessage queued_message;
+
+    TestStatusTypeFilter(queued_message);
+
+    if (s_failed != 0) {
+        printf("%u check(s) failed\n", static_cast<unsigned>(s_failed));
+        return 1;
+    }
+
+    puts("All tests passed");
+    return 0;
+}
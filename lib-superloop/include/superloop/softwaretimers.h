@@ -40,9 +40,17 @@ using TimerCallbackFunction_t = void (*)(TimerHandle_t);
 
 inline constexpr TimerHandle_t kTimerIdNone = -1;
 
+/// Lateness of the callbacks relative to their scheduled expire time
+struct SoftwareTimerStats {
+    uint32_t runs;              ///< Number of expirations
+    uint32_t late_millis_max;   ///< Worst case lateness
+    uint32_t late_millis_total; ///< Sum of the lateness, divide by runs for the average
+};
+
 TimerHandle_t SoftwareTimerAdd(uint32_t interval_millis,  TimerCallbackFunction_t k_callback);
 bool SoftwareTimerDelete(TimerHandle_t& handle);
 bool SoftwareTimerChange(TimerHandle_t handle, uint32_t interval_millis);
+bool SoftwareTimerGetStats(TimerHandle_t handle, SoftwareTimerStats& stats);
 
 void SoftwareTimerRun();
 
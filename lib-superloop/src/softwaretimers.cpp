@@ -31,6 +31,7 @@
 #endif
 
 #include <cstdint>
+#include <climits>
 #include <cstdio>
 
 #include "softwaretimers.h"
@@ -40,7 +41,7 @@
 #ifdef DEBUG_HAL_TIMERS
 #define HAL_TIMERS_DEBUG_ENTRY() DEBUG_ENTRY()
 #define HAL_TIMERS_DEBUG_EXIT() DEBUG_EXIT()
-#define HAL_TIMERS_DEBUG_PRINTF(...) HAL_TIMERS_DEBUG_PRINTF(__VA_ARGS__)
+#define HAL_TIMERS_DEBUG_PRINTF(...) DEBUG_PRINTF(__VA_ARGS__)
 #define HAL_TIMERS_DEBUG_PUTS(...) DEBUG_PUTS(__VA_ARGS__)
 #else
 #define HAL_TIMERS_DEBUG_ENTRY() \
@@ -69,14 +70,116 @@ void Error(const char* func, const char* string, TimerHandle_t handle) {
 struct Timer {
     uint32_t expire_time;                      ///< Absolute expire time in milliseconds (wrap-around safe).
     uint32_t interval_millis;                  ///< Period in milliseconds
+    uint32_t sequence;                         ///< Orders timers with the same expire time, first scheduled fires first.
+    uint32_t heap_index;                       ///< Position in s_heap, kNotQueued when the slot is free.
+    uint32_t generation;                       ///< Makes a handle of a deleted timer invalid.
     int32_t id;                                ///< Opaque handle returned to the caller.
     TimerCallbackFunction_t callback_function; ///< Callback invoked on expiry; must be non-null.
+    SoftwareTimerStats stats;
 };
 
-Timer s_timers[kSoftwareTimersMax]; ///< Timer storage pool.
-uint32_t s_timers_count = 0;        ///< Number of active timers (0..hal::SOFTWARE_TIMERS_MAX).
-int32_t s_next_id = 0;              ///< Monotonically increasing ID source (may wrap, see notes).
-uint32_t s_timer_current = 0;       ///< bRound-robin cursor for SoftwareTimerRun().
+constexpr uint32_t kNotQueued = UINT32_MAX;
+constexpr uint32_t kGenerations = static_cast<uint32_t>(INT32_MAX) / kSoftwareTimersMax;
+
+Timer s_timers[kSoftwareTimersMax];   ///< Timer storage pool, a slot does not move while the timer exists.
+uint32_t s_heap[kSoftwareTimersMax];  ///< Binary min-heap of slot indices, the next timer to expire is s_heap[0].
+uint32_t s_timers_count = 0;          ///< Number of active timers (0..kSoftwareTimersMax).
+uint32_t s_slots_used = 0;            ///< High-water mark of s_timers.
+uint32_t s_free[kSoftwareTimersMax];  ///< Stack of deleted slots below s_slots_used.
+uint32_t s_free_count = 0;
+uint32_t s_sequence = 0;
+
+/*
+ * Wrap-around safe, as long as the expire times are less than 2^31 ms apart.
+ */
+inline bool Before(const Timer& a, const Timer& b) {
+    const auto kDiff = static_cast<int32_t>(a.expire_time - b.expire_time);
+
+    if (kDiff != 0) {
+        return kDiff < 0;
+    }
+
+    return static_cast<int32_t>(a.sequence - b.sequence) < 0;
+}
+
+inline void Place(uint32_t heap_index, uint32_t slot) {
+    s_heap[heap_index] = slot;
+    s_timers[slot].heap_index = heap_index;
+}
+
+void SiftUp(uint32_t heap_index) {
+    const auto kSlot = s_heap[heap_index];
+
+    while (heap_index != 0) {
+        const auto kParent = (heap_index - 1) / 2;
+
+        if (!Before(s_timers[kSlot], s_timers[s_heap[kParent]])) {
+            break;
+        }
+
+        Place(heap_index, s_heap[kParent]);
+        heap_index = kParent;
+    }
+
+    Place(heap_index, kSlot);
+}
+
+void SiftDown(uint32_t heap_index) {
+    const auto kSlot = s_heap[heap_index];
+
+    for (;;) {
+        auto child = 2 * heap_index + 1;
+
+        if (child >= s_timers_count) {
+            break;
+        }
+
+        if (((child + 1) < s_timers_count) && Before(s_timers[s_heap[child + 1]], s_timers[s_heap[child]])) {
+            child++;
+        }
+
+        if (!Before(s_timers[s_heap[child]], s_timers[kSlot])) {
+            break;
+        }
+
+        Place(heap_index, s_heap[child]);
+        heap_index = child;
+    }
+
+    Place(heap_index, kSlot);
+}
+
+/*
+ * The expire time can move both ways, so the timer is sifted in both directions.
+ * Only one of them will move it.
+ */
+void Schedule(Timer& timer, uint32_t expire_time) {
+    timer.expire_time = expire_time;
+    timer.sequence = s_sequence++;
+
+    SiftUp(timer.heap_index);
+    SiftDown(timer.heap_index);
+}
+
+Timer* Find(TimerHandle_t handle) {
+    if (handle < 0) {
+        return nullptr;
+    }
+
+    const auto kSlot = static_cast<uint32_t>(handle) % kSoftwareTimersMax;
+
+    if (kSlot >= s_slots_used) {
+        return nullptr;
+    }
+
+    auto& timer = s_timers[kSlot];
+
+    if ((timer.heap_index == kNotQueued) || (timer.id != handle)) {
+        return nullptr;
+    }
+
+    return &timer;
+}
 } // namespace
 
 /**
@@ -89,6 +192,8 @@ uint32_t s_timer_current = 0;       ///< bRound-robin cursor for SoftwareTimerRu
  * @warning Callbacks run in the context that calls SoftwareTimerRun(). Keep them short,
  *          non-blocking, and ISR-safe *only if* SoftwareTimerRun() is called from an ISR.
  * @note    The first expiration is scheduled relative to the current @ref Millis().
+ * @note    O(log n). The handle encodes the storage slot, a handle of a deleted timer is not reused
+ *          until the slot has been reused kGenerations times.
  */
 TimerHandle_t SoftwareTimerAdd(uint32_t interval_millis, const TimerCallbackFunction_t kCallbackFunction) {
     HAL_TIMERS_DEBUG_ENTRY();
@@ -99,20 +204,22 @@ TimerHandle_t SoftwareTimerAdd(uint32_t interval_millis, const TimerCallbackFunc
         return -1;
     }
 
-    const auto kCurrentTime = timing::Millis();
-    // TODO (a) Prevent potential overflow when calculating expiration time.
+    const auto kSlot = (s_free_count != 0) ? s_free[--s_free_count] : s_slots_used++;
+    auto& timer = s_timers[kSlot];
 
-    Timer new_timer = {
-        .expire_time = kCurrentTime + interval_millis,
-        .interval_millis = interval_millis,
-        .id = s_next_id++,
-        .callback_function = kCallbackFunction,
-    };
+    timer.generation = (timer.generation + 1) % kGenerations;
+    timer.id = static_cast<int32_t>(timer.generation * kSoftwareTimersMax + kSlot);
+    timer.interval_millis = interval_millis;
+    timer.callback_function = kCallbackFunction;
+    timer.stats = SoftwareTimerStats{};
 
-    s_timers[s_timers_count++] = new_timer;
+    timer.heap_index = s_timers_count++;
+    s_heap[timer.heap_index] = kSlot;
+
+    Schedule(timer, timing::Millis() + interval_millis);
 
     HAL_TIMERS_DEBUG_EXIT();
-    return new_timer.id;
+    return timer.id;
 }
 
 /**
@@ -122,68 +229,85 @@ TimerHandle_t SoftwareTimerAdd(uint32_t interval_millis, const TimerCallbackFunc
  * @return true  If a timer with the given handle was found and removed.
  * @return false Otherwise.
  *
- * @note Deletion is O(1): the removed slot is replaced with the last active timer.
- *       This changes the order of timers.
+ * @note O(log n): the last heap entry takes the place of the removed timer and is sifted.
+ *       A timer can delete itself from its callback.
  */
 bool SoftwareTimerDelete(TimerHandle_t& handle) {
     HAL_TIMERS_DEBUG_ENTRY();
     HAL_TIMERS_DEBUG_PRINTF("s_timers_count=%u", static_cast<unsigned>(s_timers_count));
 
-    for (uint32_t i = 0; i < s_timers_count; ++i) {
-        if (s_timers[i].id == handle) {
-            // Swap with the last timer to efficiently remove the current timer
-            s_timers[i] = s_timers[s_timers_count - 1];
-            --s_timers_count;
-            // Keep the round-robin cursor within bounds.
-            if (s_timer_current >= s_timers_count) {
-                s_timer_current = 0;
-            }
+    auto* timer = Find(handle);
 
-            handle = -1;
+    if (timer == nullptr) {
+        Error(__func__, "Timer not found", handle);
 
-            HAL_TIMERS_DEBUG_ENTRY();
-            return true;
-        }
+        HAL_TIMERS_DEBUG_EXIT();
+        return false;
+    }
+
+    const auto kHeapIndex = timer->heap_index;
+    const auto kLast = s_heap[--s_timers_count];
+
+    s_free[s_free_count++] = s_heap[kHeapIndex];
+    timer->heap_index = kNotQueued;
+
+    if (kHeapIndex != s_timers_count) {
+        Place(kHeapIndex, kLast);
+        SiftUp(kHeapIndex);
+        SiftDown(s_timers[kLast].heap_index);
     }
 
-    Error(__func__, "Timer not found", handle);
+    handle = -1;
 
     HAL_TIMERS_DEBUG_EXIT();
-    return false;
+    return true;
 }
 
 /**
  * @brief Change a timer’s period and restart its countdown from now.
  *
  * @param id              Timer handle.
- * @param interval_millis New period in milliseconds (0 => one-shot).
+ * @param interval_millis New period in milliseconds (0 => every SoftwareTimerRun()).
  * @return true  On success.
  * @return false If the handle was not found.
  */
 bool SoftwareTimerChange(TimerHandle_t handle, uint32_t interval_millis) {
-    for (uint32_t i = 0; i < s_timers_count; ++i) {
-        if (s_timers[i].id == handle) {
-            const auto kCurrentTime = timing::Millis();
-            s_timers[i].expire_time = kCurrentTime + interval_millis;
-            s_timers[i].interval_millis = interval_millis;
-            return true;
-        }
+    auto* timer = Find(handle);
+
+    if (timer == nullptr) {
+        Error(__func__, "Timer not found");
+        return false;
     }
 
-    Error(__func__, "Timer not found");
+    timer->interval_millis = interval_millis;
+    Schedule(*timer, timing::Millis() + interval_millis);
 
-    return false;
+    return true;
 }
 
 /**
- * @brief Service one timer slot.
+ * @brief Get the lateness statistics of a timer, collected since SoftwareTimerAdd().
+ */
+bool SoftwareTimerGetStats(TimerHandle_t handle, SoftwareTimerStats& stats) {
+    const auto* timer = Find(handle);
+
+    if (timer == nullptr) {
+        return false;
+    }
+
+    stats = timer->stats;
+    return true;
+}
+
+/**
+ * @brief Service all expired timers, in order of their expire time.
  *
- * If the current slot has expired, its callback is invoked exactly once. The
- * timer is then rescheduled if it is periodic.
+ * Each expired timer is rescheduled before its callback is invoked, so the
+ * callback can change or delete its own timer.
  *
- * @note This function is intentionally O(1) per invocation.
- * @note If callbacks delete or add timers, this remains safe due to the
- *       swap-delete approach and the post-callback cursor normalization.
+ * @note A timer fires at most once per invocation: timers that are scheduled
+ *       during this invocation, including those with a 0 ms interval, are
+ *       left for the next one.
  */
 void SoftwareTimerRun() {
     if (s_timers_count == 0) [[unlikely]] {
@@ -191,22 +315,30 @@ void SoftwareTimerRun() {
     }
 
     const uint32_t kNow = timing::Millis();
-    Timer& timer = s_timers[s_timer_current];
+    const uint32_t kSequence = s_sequence;
+
+    while (s_timers_count != 0) {
+        auto& timer = s_timers[s_heap[0]];
+        const auto kLate = static_cast<int32_t>(kNow - timer.expire_time);
+
+        if ((kLate < 0) || (static_cast<int32_t>(timer.sequence - kSequence) >= 0)) [[likely]] {
+            return;
+        }
+
+        auto& stats = timer.stats;
+        stats.runs++;
+        stats.late_millis_total += static_cast<uint32_t>(kLate);
+
+        if (static_cast<uint32_t>(kLate) > stats.late_millis_max) {
+            stats.late_millis_max = static_cast<uint32_t>(kLate);
+        }
 
-    if (static_cast<int32_t>(kNow - timer.expire_time) >= 0) [[unlikely]] {
         const int32_t kId = timer.id;
-        const uint32_t kInterval = timer.interval_millis;
         auto callback_function = timer.callback_function;
 
-        callback_function(kId);
-
         // reschedule from NOW to avoid pile-ups after delays
-        s_timers[s_timer_current].expire_time = kNow + kInterval;
-    }
+        Schedule(timer, kNow + timer.interval_millis);
 
-    // Advance round-robin cursor (bounded next call).
-    ++s_timer_current;
-    if (s_timer_current >= s_timers_count) {
-        s_timer_current = 0;
+        callback_function(kId);
     }
 }
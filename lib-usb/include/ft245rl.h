@@ -35,5 +35,6 @@ uint8_t FT245RL_read_data();
 
 bool FT245RL_can_write();
 void FT245RL_write_data(uint8_t);
+void FT245RL_write_burst(const uint8_t* data, uint32_t length);
 
 #endif /* FT245RL_H_ */
@@ -32,6 +32,7 @@
 
 uint8_t usb_read_byte();
 void usb_send_byte(uint8_t);
+void usb_send_bytes(const uint8_t* data, uint32_t length);
 
 inline bool usb_read_is_byte_available() {
 	return FT245RL_data_available();
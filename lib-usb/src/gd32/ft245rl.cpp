@@ -49,9 +49,62 @@
 #define GPIOA_DATA_PINS (GPIO_PIN_6 | GPIO_PIN_14 | GPIO_PIN_15)
 #define GPIOB_DATA_PINS (GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_8 | GPIO_PIN_9)
 
+/*
+ * The data byte as GPIO_BOP values, the lower 16 bits set the pins, the upper 16 bits clear the pins.
+ * So the 8 data pins are written with 2 stores.
+ */
+struct BopMask
+{
+    uint32_t gpioa;
+    uint32_t gpiob;
+};
+
+struct BopTable
+{
+    BopMask mask[256];
+};
+
+static constexpr BopMask MakeBopMask(uint32_t data)
+{
+    uint32_t pin_a = 0;
+    pin_a |= (data & 4) ? (GPIO_PIN_6) : 0;   // D2
+    pin_a |= (data & 8) ? (GPIO_PIN_14) : 0;  // D3
+    pin_a |= (data & 16) ? (GPIO_PIN_15) : 0; // D4
+
+    uint32_t pin_b = 0;
+    pin_b |= (data & 1) ? (GPIO_PIN_9) : 0;   // D0
+    pin_b |= (data & 2) ? (GPIO_PIN_8) : 0;   // D1
+    pin_b |= (data & 32) ? (GPIO_PIN_4) : 0;  // D5
+    pin_b |= (data & 64) ? (GPIO_PIN_5) : 0;  // D6
+    pin_b |= (data & 128) ? (GPIO_PIN_3) : 0; // D7
+
+    return BopMask{pin_a | ((pin_a ^ GPIOA_DATA_PINS) << 16), pin_b | ((pin_b ^ GPIOB_DATA_PINS) << 16)};
+}
+
+static constexpr BopTable MakeBopTable()
+{
+    BopTable table{};
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        table.mask[i] = MakeBopMask(i);
+    }
+    return table;
+}
+
+static constexpr BopTable kBopTable = MakeBopTable();
+
+static bool s_data_output;
+
 // Set the GPIOs for data to output
 static void DataGpioFselOutput()
 {
+    if (s_data_output)
+    {
+        return;
+    }
+
+    s_data_output = true;
+
     gpio_init(GPIOA, GPIO_MODE_OUT_PP, GPIO_OSPEED_50MHZ, GPIOA_DATA_PINS);
     gpio_init(GPIOB, GPIO_MODE_OUT_PP, GPIO_OSPEED_50MHZ, GPIOB_DATA_PINS);
 }
@@ -59,10 +112,43 @@ static void DataGpioFselOutput()
 // Set the GPIOs for data to input
 static void DataGpioFselInput()
 {
+    if (!s_data_output)
+    {
+        return;
+    }
+
+    s_data_output = false;
+
     gpio_init(GPIOA, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, GPIOA_DATA_PINS);
     gpio_init(GPIOB, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, GPIOB_DATA_PINS);
 }
 
+static inline void WriteByte(uint8_t data)
+{
+    // Raise WR to start the write.
+    Gd32GpioSet(WR);
+
+    uint8_t i = NOP_COUNT_WRITE;
+    for (; i > 0; i--)
+    {
+        __NOP();
+    }
+
+    // Put the data on the bus.
+    const auto& mask = kBopTable.mask[data];
+    GPIO_BOP(GPIOA) = mask.gpioa;
+    GPIO_BOP(GPIOB) = mask.gpiob;
+
+    i = NOP_COUNT_WRITE;
+    for (; i > 0; i--)
+    {
+        __NOP();
+    }
+
+    // Drop WR to tell the FT245 to read the data.
+    Gd32GpioClr(WR);
+}
+
 /**
  * Set RD#, WR to output, TXE#, RXF# to input.
  * Set RD# to high, set WR to low
@@ -75,6 +161,7 @@ void FT245RL_init()
 
     gpio_pin_remap_config(GPIO_SWJ_DISABLE_REMAP, ENABLE);
 
+    s_data_output = true;
     DataGpioFselInput();
 
     // _RD, WR output
@@ -95,43 +182,24 @@ void FT245RL_init()
 void FT245RL_write_data(uint8_t data)
 {
     DataGpioFselOutput();
-    // Raise WR to start the write.
-    Gd32GpioSet(WR);
-
-    uint8_t i = NOP_COUNT_WRITE;
-    for (; i > 0; i--)
-    {
-        __NOP();
-    }
-
-    // Put the data on the bus.
+    WriteByte(data);
+}
 
-    uint32_t pin = 0;
-    pin |= (data & 4) ? (GPIO_PIN_6) : 0;   // D2
-    pin |= (data & 8) ? (GPIO_PIN_14) : 0;  // D3
-    pin |= (data & 16) ? (GPIO_PIN_15) : 0; // D4
-    GPIO_BOP(GPIOA) = pin;
-    pin ^= GPIOA_DATA_PINS;
-    GPIO_BC(GPIOA) = pin;
-
-    pin = 0;
-    pin |= (data & 1) ? (GPIO_PIN_9) : 0;   // D0
-    pin |= (data & 2) ? (GPIO_PIN_8) : 0;   // D1
-    pin |= (data & 32) ? (GPIO_PIN_4) : 0;  // D5
-    pin |= (data & 64) ? (GPIO_PIN_5) : 0;  // D6
-    pin |= (data & 128) ? (GPIO_PIN_3) : 0; // D7
-    GPIO_BOP(GPIOB) = pin;
-    pin ^= GPIOB_DATA_PINS;
-    GPIO_BC(GPIOB) = pin;
+/**
+ * Write a complete message to USB.
+ * The data GPIOs stay in output mode, TXE# is polled before each byte.
+ */
+void FT245RL_write_burst(const uint8_t* data, uint32_t length)
+{
+    DataGpioFselOutput();
 
-    i = NOP_COUNT_WRITE;
-    for (; i > 0; i--)
+    for (uint32_t i = 0; i < length; i++)
     {
-        __NOP();
+        // Wait for TXE# low
+        while ((GPIO_ISTAT(GPIOA) & GPIO_PIN_13) != 0)
+            ;
+        WriteByte(data[i]);
     }
-
-    // Drop WR to tell the FT245 to read the data.
-    Gd32GpioClr(WR);
 }
 
 /**
@@ -41,3 +41,7 @@ void usb_send_byte(uint8_t byte) {
 		;
 	FT245RL_write_data(byte);
 }
+
+void usb_send_bytes(const uint8_t* data, uint32_t length) {
+	FT245RL_write_burst(data, length);
+}
@@ -34,6 +34,8 @@
 
 #include "dmx.h"
 #include "rdmdevice.h"
+#include "rdmdiscovery.h"
+#include "rdm_tod.h"
 #include "usb.h"
 
 namespace widget
@@ -50,12 +52,23 @@ enum class SendState
     kOnDataChangeOnly = 1 ///< Requests the Widget to send a DMX packet to the host only when the DMX values change on the input port
 };
 
+enum class ReceiveState
+{
+    kStartCode, ///< Waiting for the start of message delimiter
+    kLabel,
+    kLengthLsb,
+    kLengthMsb,
+    kData,
+    kEndCode ///< Waiting for the end of message delimiter
+};
+
 enum class Mode
 {
     kDmxRdm = 0,    ///< Both DMX (FIRMWARE_NORMAL_DMX)and RDM (FIRMWARE_RDM) firmware enabled.
     kDmx = 1,       ///< DMX (FIRMWARE_NORMAL_DMX) firmware enabled
     kRdm = 2,       ///< RDM (FIRMWARE_RDM) firmware enabled.
-    kRdmSniffer = 3 ///< RDM Sniffer firmware enabled.
+    kRdmSniffer = 3,       ///< RDM Sniffer firmware enabled.
+    kRdmSnifferCompact = 4 ///< RDM Sniffer firmware enabled, compact frame records (\ref SNIFFER_COMPACT_PACKET)
 };
 } // namespace widget
 
@@ -78,6 +91,8 @@ class Widget : public Dmx
 
     void SetMode(widget::Mode mode) { mode_ = mode; }
 
+    bool IsSniffer() const { return (mode_ == widget::Mode::kRdmSniffer) || (mode_ == widget::Mode::kRdmSnifferCompact); }
+
     uint32_t GetReceivedDmxPacketPeriodMillis() const { return received_dmx_packet_period_millis_; }
 
     void SetReceivedDmxPacketPeriodMillis(uint32_t period) { received_dmx_packet_period_millis_ = period; }
@@ -95,6 +110,7 @@ class Widget : public Dmx
         ReceivedDmxChangeOfStatePacket();
         ReceivedRdmPacket();
         RdmTimeout();
+        RdmDiscoveryRun();
         SnifferRdm();
         SnifferDmx();
     }
@@ -113,21 +129,23 @@ class Widget : public Dmx
     void SendRdmDiscoveryRequest(uint16_t data_length);
     void GetManufacturerReply();
     void RdmTimeOutMessage();
+    void RdmDiscovery(uint16_t data_length);
+    void RdmDiscoveryReply();
     // Run
     void ReceiveDataFromHost();
+    void ReceivedMessageFromHost(uint8_t label, uint16_t data_length);
     void ReceivedDmxPacket();
     void ReceivedDmxChangeOfStatePacket();
     void ReceivedRdmPacket();
     void RdmTimeout();
+    void RdmDiscoveryRun();
     void SnifferRdm();
     void SnifferDmx();
     // USB
     void SendHeader(uint8_t label, uint32_t length)
     {
-        usb_send_byte(static_cast<uint8_t>(widget::Amf::kStartCode));
-        usb_send_byte(label);
-        usb_send_byte(static_cast<uint8_t>(length & 0x00FF));
-        usb_send_byte(static_cast<uint8_t>(length >> 8));
+        const uint8_t kHeader[4] = {static_cast<uint8_t>(widget::Amf::kStartCode), label, static_cast<uint8_t>(length & 0x00FF), static_cast<uint8_t>(length >> 8)};
+        usb_send_bytes(kHeader, sizeof(kHeader));
     }
 
     void SendMessage(uint8_t label, const uint8_t* data, uint32_t length)
@@ -137,22 +155,25 @@ class Widget : public Dmx
         SendFooter();
     }
 
-    void SendData(const uint8_t* data, uint32_t length)
-    {
-        for (uint32_t i = 0; i < length; i++)
-        {
-            usb_send_byte(data[i]);
-        }
-    }
+    void SendData(const uint8_t* data, uint32_t length) { usb_send_bytes(data, length); }
 
     void SendFooter() { usb_send_byte(static_cast<uint8_t>(widget::Amf::kEndCode)); }
     //
     void UsbSendPackage(const uint8_t* data, uint16_t start, uint16_t data_length);
+    void UsbSendRecord(const uint8_t* data, uint16_t data_length);
     bool UsbCanSend();
 
    private:
     static constexpr uint32_t kWidgetDataBufferSize = 600;
+    static constexpr uint32_t kUsbReceiveBufferSize = 128; ///< FT245RL receive buffer
+    static constexpr uint32_t kCosSlots = 40; ///< Slots covered by one Received DMX Change Of State Packet
     uint8_t data_[kWidgetDataBufferSize]; ///< Message between widget and the USB host
+    uint8_t cos_data_[dmx::buffer::kSize]{}; ///< The DMX data as known by the USB host, for the change of state packets
+    bool is_cos_full_compare_{true};        ///< Compare all slots with cos_data_, not only the slots changed since the previous frame
+    widget::ReceiveState receive_state_{widget::ReceiveState::kStartCode};
+    uint8_t receive_label_{0};
+    uint16_t receive_length_{0};
+    uint32_t receive_index_{0};
     widget::Mode mode_{widget::Mode::kDmxRdm};
     widget::SendState send_state_{widget::SendState::kAlways};
     uint32_t received_dmx_packet_period_millis_{0};
@@ -161,6 +182,8 @@ class Widget : public Dmx
     bool is_rdm_discovery_running_{false};
     uint32_t received_dmx_packet_count_{0};
     TRdmStatistics rdm_statistics_;
+    RDMDiscovery rdm_discovery_;
+    rdm::Tod tod_;
 
     inline static Widget* s_this;
 };
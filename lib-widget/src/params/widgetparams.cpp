@@ -109,7 +109,7 @@ void WidgetParams::CallbackFunction(const char* line) {
     }
 
     if (Sscan::Uint8(line, WidgetParamsConst::WIDGET_MODE, value8) == Sscan::OK) {
-        if (value8 <= static_cast<uint8_t>(widget::Mode::kRdmSniffer)) {
+        if (value8 <= static_cast<uint8_t>(widget::Mode::kRdmSnifferCompact)) {
             store_widget_.mode = value8;
             store_widget_.set_list |= WidgetParamsMask::kMode;
             return;
@@ -28,6 +28,8 @@
  */
 
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
 
 #include "widget.h"
 #include "widgetconfiguration.h"
@@ -56,7 +58,8 @@ enum
     kSendRdmDiscoveryRequest = 11,         ///< Send RDM Discovery Request
     kRdmTimeout = 12,                        ///< https://github.com/OpenLightingProject/ola/blob/master/plugins/usbpro/EnttecUsbProWidget.cpp#L353
     kManufacturerLabel = 77,                 ///< https://wiki.openlighting.org/index.php/USB_Protocol_Extensions
-    kGetWidgetNameLabel = 78               ///< https://wiki.openlighting.org/index.php/USB_Protocol_Extensions
+    kGetWidgetNameLabel = 78,              ///< https://wiki.openlighting.org/index.php/USB_Protocol_Extensions
+    kRdmDiscoveryLabel = 80                  ///< Run the RDM discovery in the widget, the reply is the TOD
 };
 
 Widget::Widget()
@@ -129,7 +132,7 @@ void Widget::SetParams()
  */
 void Widget::ReceivedDmxPacket()
 {
-    if (mode_ == widget::Mode::kRdmSniffer)
+    if (IsSniffer())
     {
         return;
     }
@@ -182,7 +185,7 @@ void Widget::ReceivedDmxPacket()
  */
 void Widget::ReceivedRdmPacket()
 {
-    if ((mode_ == widget::Mode::kDmx) || (mode_ == widget::Mode::kRdmSniffer) || (send_state_ == widget::SendState::kOnDataChangeOnly))
+    if ((mode_ == widget::Mode::kDmx) || IsSniffer() || (send_state_ == widget::SendState::kOnDataChangeOnly) || rdm_discovery_.IsRunning())
     {
         return;
     }
@@ -313,7 +316,7 @@ void Widget::SendRdmPacketRequest(uint16_t data_length)
  */
 void Widget::RdmTimeout()
 {
-    if (mode_ == widget::Mode::kRdmSniffer)
+    if (IsSniffer())
     {
         return;
     }
@@ -357,6 +360,9 @@ void Widget::ReceiveDmxOnChange()
 
     Dmx::SetPortDirection(0, dmx::Direction::kInput, false);
     Dmx::ClearData(0);
+    memset(cos_data_, 0, sizeof(cos_data_));
+    // The previous frame in Dmx is not what the host knows, with static input GetDmxChanged would not report anything
+    is_cos_full_compare_ = true;
     Dmx::SetPortDirection(0, dmx::Direction::kInput, true);
 
     received_dmx_packet_start_millis_ = timing::Millis();
@@ -372,7 +378,7 @@ void Widget::ReceiveDmxOnChange()
  */
 void Widget::ReceivedDmxChangeOfStatePacket()
 {
-    if (mode_ == widget::Mode::kRdmSniffer)
+    if (IsSniffer())
     {
         return;
     }
@@ -382,13 +388,94 @@ void Widget::ReceivedDmxChangeOfStatePacket()
         return;
     }
 
-    if (nullptr != Dmx::GetDmxChanged(0))
+    dmx::ChangedSlots changed;
+    const uint8_t* dmx_data_changed;
+
+    if (is_cos_full_compare_)
+    {
+        dmx_data_changed = Dmx::GetDmxAvailable(0);
+
+        if (dmx_data_changed == nullptr)
+        {
+            return;
+        }
+
+        // Keeps the previous frame up to date, the result is not used
+        static_cast<void>(Dmx::GetDmxChangedSlots(0, changed));
+
+        is_cos_full_compare_ = false;
+
+        changed.first = 0;
+        changed.last = dmx::kChannelsMax;
+        changed.blocks = UINT32_MAX;
+    }
+    else
     {
+        dmx_data_changed = Dmx::GetDmxChanged(0, changed);
+
+        if (dmx_data_changed == nullptr)
+        {
+            return;
+        }
+    }
+
 #if !defined(NO_HDMI_OUTPUT)
-        WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "RECEIVED_DMX_COS_TYPE");
-        WidgetMonitor::Line(widgetmonitor::MonitorLine::kStatus, nullptr);
-        // TODO (a) widget_received_dmx_change_of_state_packet
-        WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "Sent changed DMX data to HOST");
+    WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "RECEIVED_DMX_COS_TYPE");
+    WidgetMonitor::Line(widgetmonitor::MonitorLine::kStatus, nullptr);
+#endif
+
+    const auto* dmx_statistics = reinterpret_cast<const struct Data*>(dmx_data_changed);
+    const auto kLast = std::min(changed.last, dmx_statistics->statistics.slots_in_packet); // slots_in_packet excludes the start code
+
+    uint32_t messages = 0;
+
+    /*
+     * Byte 0    : Start changed byte number, in units of 8 slots
+     * Byte 1-5  : Changed bit array, bit 0 is the slot at the start byte number
+     * Byte 6-45 : One byte for each set bit in the changed bit array
+     */
+    for (auto start = changed.first & ~7U; start <= kLast; start += kCosSlots)
+    {
+        const auto kBlockFirst = start / dmx::kChangedBlockSlots;
+        const auto kBlockLast = (start + kCosSlots - 1) / dmx::kChangedBlockSlots;
+        const auto kBlockMask = ((2U << (kBlockLast - kBlockFirst)) - 1) << kBlockFirst;
+
+        if ((changed.blocks & kBlockMask) == 0)
+        {
+            continue;
+        }
+
+        uint8_t message[1 + kCosSlots / 8 + kCosSlots];
+        uint32_t length = 1 + kCosSlots / 8;
+
+        message[0] = static_cast<uint8_t>(start / 8);
+        memset(&message[1], 0, kCosSlots / 8);
+
+        const auto kEnd = std::min(start + kCosSlots - 1, kLast);
+
+        for (auto slot = start; slot <= kEnd; slot++)
+        {
+            if (dmx_data_changed[slot] != cos_data_[slot])
+            {
+                const auto kBit = slot - start;
+                cos_data_[slot] = dmx_data_changed[slot];
+                message[1 + (kBit >> 3)] = static_cast<uint8_t>(message[1 + (kBit >> 3)] | (1U << (kBit & 7)));
+                message[length++] = dmx_data_changed[slot];
+            }
+        }
+
+        if (length > (1 + kCosSlots / 8))
+        {
+            SendMessage(kReceivedDmxCosType, message, length);
+            messages++;
+        }
+    }
+
+    if (messages != 0)
+    {
+        received_dmx_packet_count_++;
+#if !defined(NO_HDMI_OUTPUT)
+        WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "Sent changed DMX data to HOST, %u", static_cast<unsigned>(messages));
 #endif
     }
 }
@@ -523,6 +610,84 @@ void Widget::GetNameReply()
     received_dmx_packet_start_millis_ = timing::Millis();
 }
 
+/**
+ *
+ * RDM Discovery (Label = 80 RDM_DISCOVERY_LABEL)
+ *
+ * The discovery runs in the widget, the host only receives the result.
+ * data_[0] = 0 (or no data) full discovery, data_[0] = 1 incremental discovery.
+ * Incremental discovery keeps the known devices muted and only searches for new devices.
+ *
+ * @param data_length 0 or 1
+ */
+void Widget::RdmDiscovery(uint16_t data_length)
+{
+    if ((mode_ != widget::Mode::kDmxRdm) && (mode_ != widget::Mode::kRdm))
+    {
+        return;
+    }
+
+#if !defined(NO_HDMI_OUTPUT)
+    WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "RDM_DISCOVERY_LABEL");
+    WidgetMonitor::Line(widgetmonitor::MonitorLine::kStatus, nullptr);
+#endif
+
+    send_rdm_packet_start_millis_ = 0;
+    rdm_discovery_.SetSrcUid(rdm::device::Base::Instance().GetUID());
+
+    if ((data_length != 0) && (data_[0] == 1))
+    {
+        rdm_discovery_.Incremental(0, &tod_);
+    }
+    else
+    {
+        rdm_discovery_.Full(0, &tod_);
+    }
+}
+
+/**
+ *
+ * RDM Discovery Reply (Label = 80 RDM_DISCOVERY_LABEL)
+ *
+ * The UIDs found, 6 bytes each.
+ */
+void Widget::RdmDiscoveryReply()
+{
+    const auto kUidCount = tod_.UidCount();
+
+#if !defined(NO_HDMI_OUTPUT)
+    WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "RDM_DISCOVERY_LABEL, UIDs:%d", static_cast<int>(kUidCount));
+    WidgetMonitor::Line(widgetmonitor::MonitorLine::kStatus, nullptr);
+#endif
+
+    SendHeader(kRdmDiscoveryLabel, kUidCount * rdm::kUidSize);
+
+    for (uint32_t index = 0; index < kUidCount; index++)
+    {
+        uint8_t uid[rdm::kUidSize];
+        tod_.CopyUidEntry(index, uid);
+        SendData(uid, rdm::kUidSize);
+    }
+
+    SendFooter();
+}
+
+/**
+ *
+ * This function is called from Run
+ *
+ */
+void Widget::RdmDiscoveryRun()
+{
+    rdm_discovery_.Run();
+
+    if (rdm_discovery_.IsFinished())
+    {
+        rdm_discovery_.Stop();
+        RdmDiscoveryReply();
+    }
+}
+
 /**
  *
  * Read bytes from host
@@ -531,62 +696,105 @@ void Widget::GetNameReply()
  */
 void Widget::ReceiveDataFromHost()
 {
-    if (usb_read_is_byte_available())
+    // Never read more than the FT245RL receive buffer, so a large message is spread over multiple Run() calls
+    for (uint32_t count = 0; (count < kUsbReceiveBufferSize) && usb_read_is_byte_available(); count++)
     {
         const auto kByte = usb_read_byte();
 
-        if (static_cast<uint8_t>(widget::Amf::kStartCode) == kByte)
+        switch (receive_state_)
         {
-            const auto kLabel = usb_read_byte();
-            const auto kLsb = usb_read_byte();
-            const auto kMsb = usb_read_byte();
-            const auto kDataLength = static_cast<uint16_t>((kMsb << 8) | kLsb);
-
-            uint32_t i;
-
-            for (i = 0; i < kDataLength; i++)
-            {
-                data_[i] = usb_read_byte();
-            }
-
-            while ((static_cast<uint8_t>(widget::Amf::kEndCode) != usb_read_byte()) && (i++ < (sizeof(data_) / sizeof(data_[0]))));
+            case widget::ReceiveState::kStartCode:
+                if (static_cast<uint8_t>(widget::Amf::kStartCode) == kByte)
+                {
+                    receive_state_ = widget::ReceiveState::kLabel;
+                }
+                break;
+            case widget::ReceiveState::kLabel:
+                receive_label_ = kByte;
+                receive_state_ = widget::ReceiveState::kLengthLsb;
+                break;
+            case widget::ReceiveState::kLengthLsb:
+                receive_length_ = kByte;
+                receive_state_ = widget::ReceiveState::kLengthMsb;
+                break;
+            case widget::ReceiveState::kLengthMsb:
+                receive_length_ = static_cast<uint16_t>((kByte << 8) | receive_length_);
+                receive_index_ = 0;
+                receive_state_ = (receive_length_ == 0) ? widget::ReceiveState::kEndCode : widget::ReceiveState::kData;
+                break;
+            case widget::ReceiveState::kData:
+                if (receive_index_ < sizeof(data_))
+                {
+                    data_[receive_index_] = kByte;
+                }
+                if (++receive_index_ == receive_length_)
+                {
+                    receive_state_ = widget::ReceiveState::kEndCode;
+                }
+                break;
+            case widget::ReceiveState::kEndCode:
+                if (static_cast<uint8_t>(widget::Amf::kEndCode) == kByte)
+                {
+                    receive_state_ = widget::ReceiveState::kStartCode;
+                    // Only complete messages are handled, one per Run()
+                    ReceivedMessageFromHost(receive_label_, static_cast<uint16_t>(std::min(static_cast<uint32_t>(receive_length_), static_cast<uint32_t>(sizeof(data_)))));
+                    return;
+                }
+                // Framing error, the message is dropped. The byte can be the start of the next message.
+                receive_state_ = (static_cast<uint8_t>(widget::Amf::kStartCode) == kByte) ? widget::ReceiveState::kLabel : widget::ReceiveState::kStartCode;
+                break;
+            default:
+                [[unlikely]] receive_state_ = widget::ReceiveState::kStartCode;
+                break;
+        }
+    }
+}
 
+void Widget::ReceivedMessageFromHost(uint8_t label, uint16_t data_length)
+{
 #if !defined(NO_HDMI_OUTPUT)
-            WidgetMonitor::Line(widgetmonitor::MonitorLine::kLabel, "L:%d:%d(%d)", kLabel, kDataLength, i);
+    WidgetMonitor::Line(widgetmonitor::MonitorLine::kLabel, "L:%d:%d(%d)", label, data_length, receive_index_);
 #endif
 
-            switch (kLabel)
-            {
-                case kGetWidgetParams:
-                    GetParamsReply();
-                    break;
-                case kGetWidgetSnRequest:
-                    GetSnReply();
-                    break;
-                case kSetWidgetParams:
-                    SetParams();
-                    break;
-                case kGetWidgetNameLabel:
-                    GetNameReply();
-                    break;
-                case kManufacturerLabel:
-                    GetManufacturerReply();
-                    break;
-                case kOutputOnlySendDmxPacketRequest:
-                    SendDmxPacketRequestOutputOnly(kDataLength);
-                    break;
-                case kReceiveDmxOnChange:
-                    ReceiveDmxOnChange();
-                    break;
-                case kSendRdmPacketRequest:
-                    SendRdmPacketRequest(kDataLength);
-                    break;
-                case kSendRdmDiscoveryRequest:
-                    SendRdmDiscoveryRequest(kDataLength);
-                    break;
-                default:
-                    break;
-            }
-        }
+    // The DMX port is in use by the discovery
+    if (rdm_discovery_.IsRunning() && ((label == kOutputOnlySendDmxPacketRequest) || (label == kSendRdmPacketRequest) || (label == kSendRdmDiscoveryRequest) || (label == kRdmDiscoveryLabel)))
+    {
+        return;
+    }
+
+    switch (label)
+    {
+        case kGetWidgetParams:
+            GetParamsReply();
+            break;
+        case kGetWidgetSnRequest:
+            GetSnReply();
+            break;
+        case kSetWidgetParams:
+            SetParams();
+            break;
+        case kGetWidgetNameLabel:
+            GetNameReply();
+            break;
+        case kManufacturerLabel:
+            GetManufacturerReply();
+            break;
+        case kOutputOnlySendDmxPacketRequest:
+            SendDmxPacketRequestOutputOnly(data_length);
+            break;
+        case kReceiveDmxOnChange:
+            ReceiveDmxOnChange();
+            break;
+        case kSendRdmPacketRequest:
+            SendRdmPacketRequest(data_length);
+            break;
+        case kSendRdmDiscoveryRequest:
+            SendRdmDiscoveryRequest(data_length);
+            break;
+        case kRdmDiscoveryLabel:
+            RdmDiscovery(data_length);
+            break;
+        default:
+            break;
     }
 }
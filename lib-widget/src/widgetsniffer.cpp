@@ -23,6 +23,7 @@
  */
 
 #include <cstdint>
+#include <algorithm>
 
 #include "widget.h"
 #include "timing.h"
@@ -39,6 +40,45 @@
 #define CONTROL_MASK 0x00       ///< If the high bit is set, this is a data byte, otherwise it's a control byte
 #define DATA_MASK 0x80          ///< If the high bit is set, this is a data byte, otherwise it's a control byte
 
+#define SNIFFER_COMPACT_PACKET 0x82    ///< Label
+#define SNIFFER_COMPACT_HEADER_SIZE 10 ///< Record header size
+
+/**
+ * Compact sniffer record (Label = 0x82 SNIFFER_COMPACT_PACKET), one frame per message, little endian.
+ *
+ * Byte 0-3 : Timestamp in microseconds of the BREAK, when not measured the time the frame was handed to the USB
+ * Byte 4-5 : Length, including the start code
+ * Byte 6-7 : BREAK + MAB time in microseconds, 0 when not measured
+ * Byte 8-9 : Frame time (start code to last slot) in microseconds, 0 when not measured
+ * Byte 10- : The frame, beginning with the start code
+ */
+void Widget::UsbSendRecord(const uint8_t* data, uint16_t data_length)
+{
+    auto micros = timing::Micros();
+    uint16_t break_mab_time = 0;
+    uint16_t frame_time = 0;
+
+    dmx::ReceiveTiming receive_timing;
+
+    if (Dmx::GetDmxReceiveTiming(0, receive_timing) && (receive_timing.start_code == data[0]))
+    {
+        micros -= receive_timing.break_age;
+        break_mab_time = static_cast<uint16_t>(std::min(receive_timing.break_mab_time, static_cast<uint32_t>(UINT16_MAX)));
+        frame_time = static_cast<uint16_t>(std::min(receive_timing.frame_time, static_cast<uint32_t>(UINT16_MAX)));
+    }
+
+    const uint8_t kRecord[SNIFFER_COMPACT_HEADER_SIZE] = {
+        static_cast<uint8_t>(micros), static_cast<uint8_t>(micros >> 8), static_cast<uint8_t>(micros >> 16), static_cast<uint8_t>(micros >> 24),
+        static_cast<uint8_t>(data_length), static_cast<uint8_t>(data_length >> 8),
+        static_cast<uint8_t>(break_mab_time), static_cast<uint8_t>(break_mab_time >> 8),
+        static_cast<uint8_t>(frame_time), static_cast<uint8_t>(frame_time >> 8)};
+
+    SendHeader(SNIFFER_COMPACT_PACKET, static_cast<uint32_t>(SNIFFER_COMPACT_HEADER_SIZE + data_length));
+    SendData(kRecord, SNIFFER_COMPACT_HEADER_SIZE);
+    SendData(data, data_length);
+    SendFooter();
+}
+
 void Widget::UsbSendPackage(const uint8_t* data, uint16_t start, uint16_t data_length)
 {
     uint32_t i;
@@ -101,12 +141,13 @@ bool Widget::UsbCanSend()
  */
 void Widget::SnifferDmx()
 {
-    if ((GetMode() != widget::Mode::kRdmSniffer) || !UsbCanSend())
+    if (!IsSniffer() || !UsbCanSend())
     {
         return;
     }
 
-    const auto* dmx_data_changed = Dmx::GetDmxChanged(0);
+    // The compact records are small enough to send every frame
+    const auto* dmx_data_changed = (GetMode() == widget::Mode::kRdmSnifferCompact) ? Dmx::GetDmxAvailable(0) : Dmx::GetDmxChanged(0);
 
     if (dmx_data_changed == nullptr)
     {
@@ -124,6 +165,12 @@ void Widget::SnifferDmx()
 #if !defined(NO_HDMI_OUTPUT)
     WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "Send DMX data to HOST -> %d", kDataLength);
 #endif
+    if (GetMode() == widget::Mode::kRdmSnifferCompact)
+    {
+        UsbSendRecord(dmx_data_changed, static_cast<uint16_t>(kDataLength));
+        return;
+    }
+
     UsbSendPackage(dmx_data_changed, 0, static_cast<uint16_t>(kDataLength));
 }
 
@@ -132,7 +179,7 @@ void Widget::SnifferDmx()
  */
 void Widget::SnifferRdm()
 {
-    if ((GetMode() != widget::Mode::kRdmSniffer) || !UsbCanSend())
+    if (!IsSniffer() || !UsbCanSend())
     {
         return;
     }
@@ -182,6 +229,12 @@ void Widget::SnifferRdm()
 #if !defined(NO_HDMI_OUTPUT)
     WidgetMonitor::Line(widgetmonitor::MonitorLine::kInfo, "Send RDM data to HOST");
 #endif
+    if (GetMode() == widget::Mode::kRdmSnifferCompact)
+    {
+        UsbSendRecord(rdm_data, message_length);
+        return;
+    }
+
     UsbSendPackage(rdm_data, 0, message_length);
 }
 